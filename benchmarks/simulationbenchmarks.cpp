@@ -0,0 +1,467 @@
+#include <benchmark/benchmark.h>
+#include <QCoreApplication>
+#include <QString>
+#include <QtGlobal>
+#include <QtMath>
+#include "drone.h"
+#include "dronefactory.h"
+#include "dronepool.h"
+#include "fleetstate.h"
+#include "hoverstrategy.h"
+#include "logger.h"
+#include "movementstrategy.h"
+#include "paralleltickexecutor.h"
+#include "randomwalkstrategy.h"
+#include "separationmonitor.h"
+#include "spatialindex.h"
+#include "telemetrymodel.h"
+#include <cmath>
+
+/*
+ * Microbenchmarks for the simulation hot paths; the yardstick for performance
+ * changes. Run with --benchmark_out=results.json --benchmark_out_format=json
+ * and compare two runs with Google Benchmark's tools/compare.py.
+ *
+ * The logger runs as the applications configure it (async, INFO and above),
+ * so paths that log include that cost.
+ */
+
+namespace
+{
+constexpr quint64 BENCHMARK_SEED = 42;     // Fixed seed so every run does the same work
+constexpr int STRATEGY_SLICE_SIZE = 1024;  // Drones per batched strategy call (one tick chunk)
+constexpr int MAX_FACTORY_FLEET = 100000;  // Fleet size at which the factory benchmark starts over
+
+/**
+ * @brief Discard Qt debug output so console I/O does not end up in the measurements
+ */
+void discardMessages(QtMsgType, const QMessageLogContext&, const QString&)
+{
+}
+
+TickContext makeContext(quint64 tick)
+{
+    TickContext context;
+    context.tick = tick;
+    context.rng = CounterRng(BENCHMARK_SEED);
+    context.dt = MovementStrategy::REFERENCE_STEP_SECONDS;
+    return context;
+}
+
+/**
+ * @brief One drone per call through the per-drone adapter, including its telemetryUpdated signal
+ */
+template <typename Strategy>
+void BM_UpdatePosition(benchmark::State& state)
+{
+    Strategy strategy;
+    FleetState fleet;
+    Drone drone(&fleet, fleet.addDrone("DRONE-001"));
+    quint64 tick = 0;
+
+    for (auto _ : state)
+    {
+        strategy.updatePosition(&drone, makeContext(tick++));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief A tick chunk's worth of drones per batched call
+ */
+template <typename Strategy>
+void BM_UpdatePositions(benchmark::State& state)
+{
+    Strategy strategy;
+    FleetState fleet;
+    int count = static_cast<int>(state.range(0));
+    fleet.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        fleet.addDrone(QString("DRONE-%1").arg(i + 1, 3, 10, QChar('0')));
+    }
+    FleetSlice slice = fleet.slice();
+    quint64 tick = 0;
+
+    for (auto _ : state)
+    {
+        strategy.updatePositions(slice, makeContext(tick++));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+void BM_HoverStrategy_UpdatePosition(benchmark::State& state)
+{
+    BM_UpdatePosition<HoverStrategy>(state);
+}
+BENCHMARK(BM_HoverStrategy_UpdatePosition);
+
+void BM_RandomWalkStrategy_UpdatePosition(benchmark::State& state)
+{
+    BM_UpdatePosition<RandomWalkStrategy>(state);
+}
+BENCHMARK(BM_RandomWalkStrategy_UpdatePosition);
+
+void BM_HoverStrategy_UpdatePositions(benchmark::State& state)
+{
+    BM_UpdatePositions<HoverStrategy>(state);
+}
+BENCHMARK(BM_HoverStrategy_UpdatePositions)->Arg(STRATEGY_SLICE_SIZE);
+
+void BM_RandomWalkStrategy_UpdatePositions(benchmark::State& state)
+{
+    BM_UpdatePositions<RandomWalkStrategy>(state);
+}
+BENCHMARK(BM_RandomWalkStrategy_UpdatePositions)->Arg(STRATEGY_SLICE_SIZE);
+
+/**
+ * @brief One setter call with a connected receiver (signal emission included)
+ */
+void BM_Drone_SetLatitude(benchmark::State& state)
+{
+    FleetState fleet;
+    Drone drone(&fleet, fleet.addDrone("DRONE-001"));
+    quint64 notifications = 0;
+    QObject::connect(&drone, &Drone::telemetryUpdated, [&notifications](quint32) { ++notifications; });
+    double latitude = 28.6139;
+
+    for (auto _ : state)
+    {
+        latitude += 1e-6;
+        drone.setLatitude(latitude);
+    }
+    benchmark::DoNotOptimize(notifications);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Drone_SetLatitude);
+
+/**
+ * @brief Five setters coalesced into one notification with beginUpdate()/commitUpdate()
+ */
+void BM_Drone_BatchedUpdate(benchmark::State& state)
+{
+    FleetState fleet;
+    Drone drone(&fleet, fleet.addDrone("DRONE-001"));
+    quint64 notifications = 0;
+    QObject::connect(&drone, &Drone::telemetryUpdated, [&notifications](quint32) { ++notifications; });
+    double step = 0.0;
+
+    for (auto _ : state)
+    {
+        step += 1e-6;
+        drone.beginUpdate();
+        drone.setLatitude(28.6139 + step);
+        drone.setLongitude(77.2090 + step);
+        drone.setAltitude(100.0 + step);
+        drone.setHeading(90.0 + step);
+        drone.setSpeed(5.0 + step);
+        drone.commitUpdate();
+    }
+    benchmark::DoNotOptimize(notifications);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Drone_BatchedUpdate);
+
+/**
+ * @brief Logger::log from one producer; blocks rather than drops so this is sustained throughput
+ */
+void BM_Logger_Log(benchmark::State& state)
+{
+    Logger& logger = Logger::getInstance();
+    Logger::AsyncOptions options;
+    options.overflowPolicy = Logger::BLOCK;
+    options.echoToConsole = false;
+    logger.enableAsync(options);
+    const QString message("Drone DRONE-001 telemetry: lat=28.613900 lon=77.209000 alt=100.0");
+
+    for (auto _ : state)
+    {
+        logger.log(Logger::INFO, message);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    // Back to the configuration the other benchmarks use
+    logger.enableAsync();
+}
+BENCHMARK(BM_Logger_Log);
+
+/**
+ * @brief A LOG_DEBUG call below the runtime minimum level
+ */
+void BM_Logger_FilteredOut(benchmark::State& state)
+{
+    quint64 tick = 0;
+    for (auto _ : state)
+    {
+        LOG_DEBUG(QString("Tick %1").arg(tick++));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Logger_FilteredOut);
+
+/**
+ * @brief DroneFactory::createDrone into a fleet, including its log line and the view's lifetime
+ */
+void BM_DroneFactory_CreateDrone(benchmark::State& state)
+{
+    FleetState fleet;
+    fleet.reserve(MAX_FACTORY_FLEET);
+    const QString id("DRONE-001");
+
+    for (auto _ : state)
+    {
+        if (fleet.size() >= MAX_FACTORY_FLEET)
+        {
+            state.PauseTiming();
+            fleet.clear();
+            fleet.reserve(MAX_FACTORY_FLEET);
+            state.ResumeTiming();
+        }
+        delete DroneFactory::createDrone(&fleet, id);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DroneFactory_CreateDrone);
+
+/**
+ * @brief Spawn a drone through a DronePool and despawn it again (swarm churn at a steady fleet size)
+ */
+void BM_DronePool_SpawnDespawn(benchmark::State& state)
+{
+    FleetState fleet;
+    DronePool pool;
+    const QString id("DRONE-001");
+    for (int i = 0; i < STRATEGY_SLICE_SIZE; ++i)
+    {
+        fleet.addDrone(id);
+    }
+
+    for (auto _ : state)
+    {
+        Drone* drone = DroneFactory::acquireDrone(&pool, &fleet, id);
+        fleet.removeDrone(drone->getIndex());
+        pool.release(drone);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DronePool_SpawnDespawn);
+
+/**
+ * @brief DroneFactory::spawnDrones of a whole grid into an empty fleet; arg is the drone count
+ */
+void BM_DroneFactory_SpawnDrones(benchmark::State& state)
+{
+    SpawnDescriptor descriptor;
+    descriptor.count = static_cast<int>(state.range(0));
+    FleetState fleet;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        fleet = FleetState();
+        state.ResumeTiming();
+        int spawned = DroneFactory::spawnDrones(&fleet, descriptor);
+        benchmark::DoNotOptimize(spawned);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DroneFactory_SpawnDrones)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Fill a fleet with a random-disk swarm of the given size (5 km radius)
+ */
+void spawnSwarm(FleetState& fleet, int droneCount)
+{
+    SpawnDescriptor descriptor;
+    descriptor.pattern = SpawnDescriptor::RANDOM_DISK_PATTERN;
+    descriptor.count = droneCount;
+    descriptor.radius = 5000.0;
+    descriptor.seed = BENCHMARK_SEED;
+    DroneFactory::spawnDrones(&fleet, descriptor);
+}
+
+/**
+ * @brief SpatialIndex::update after every drone moved a little; arg is the drone count
+ * Alternates between two position sets so every iteration re-buckets.
+ */
+void BM_SpatialIndex_Update(benchmark::State& state)
+{
+    FleetState fleet;
+    spawnSwarm(fleet, static_cast<int>(state.range(0)));
+    SpatialIndex index;
+    double offset = SpatialIndex::DEFAULT_CELL_SIZE / 111320.0;
+
+    for (auto _ : state)
+    {
+        FleetSlice all = fleet.slice();
+        for (int i = 0; i < all.count; ++i)
+        {
+            all.latitudes[i] += offset;
+        }
+        offset = -offset;
+        index.update(fleet);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpatialIndex_Update)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief SpatialIndex::update of a cruising swarm; arg is the drone count
+ * Every drone flies 1 m per tick (10 m/s at 10 Hz) on its own heading, so a
+ * few percent change cell each tick; they are merged into the index as moved
+ * drones, with a full re-bucket only every few ticks.
+ */
+void BM_SpatialIndex_UpdateMoving(benchmark::State& state)
+{
+    FleetState fleet;
+    spawnSwarm(fleet, static_cast<int>(state.range(0)));
+    QVector<double> latitudeSteps(fleet.size());
+    QVector<double> longitudeSteps(fleet.size());
+    for (int i = 0; i < fleet.size(); ++i)
+    {
+        double heading = i * 2.399963; // Golden angle spreads the headings evenly
+        latitudeSteps[i] = std::cos(heading) / 111320.0;
+        longitudeSteps[i] = std::sin(heading) / (111320.0 * std::cos(qDegreesToRadians(fleet.latitudes()[i])));
+    }
+    SpatialIndex index;
+    index.update(fleet);
+    qint64 rebuilds = 0;
+
+    for (auto _ : state)
+    {
+        FleetSlice all = fleet.slice();
+        for (int i = 0; i < all.count; ++i)
+        {
+            all.latitudes[i] += latitudeSteps[i];
+            all.longitudes[i] += longitudeSteps[i];
+        }
+        index.update(fleet);
+        rebuilds += index.wasRebuilt() ? 1 : 0;
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["rebuilds"] = benchmark::Counter(static_cast<double>(rebuilds), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SpatialIndex_UpdateMoving)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief 50 m radius query in a 100,000-drone swarm
+ */
+void BM_SpatialIndex_QueryRadius(benchmark::State& state)
+{
+    FleetState fleet;
+    spawnSwarm(fleet, 100000);
+    SpatialIndex index;
+    index.update(fleet);
+    QVector<int> result;
+    int probe = 0;
+
+    for (auto _ : state)
+    {
+        index.queryRadius(fleet.latitudes()[probe], fleet.longitudes()[probe], 50.0, result);
+        probe = (probe + 7919) % fleet.size();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpatialIndex_QueryRadius);
+
+/**
+ * @brief Separation check of a 50,000-drone swarm; arg is the thread count (0 = one per core)
+ * Must stay well inside a 100 ms tick for 10 Hz; the swarm averages a couple
+ * of drones within the 30 m default minimum of each other.
+ */
+void BM_SeparationMonitor_Detect(benchmark::State& state)
+{
+    FleetState fleet;
+    spawnSwarm(fleet, 50000);
+    ParallelTickExecutor executor(static_cast<int>(state.range(0)));
+    SpatialIndex index;
+    index.update(fleet, &executor);
+    SeparationMonitor monitor;
+
+    for (auto _ : state)
+    {
+        monitor.detect(fleet, index, &executor);
+        qint64 conflictCount = monitor.getConflictCount();
+        benchmark::DoNotOptimize(conflictCount);
+    }
+    state.SetItemsProcessed(state.iterations() * fleet.size());
+}
+BENCHMARK(BM_SeparationMonitor_Detect)->ArgName("threads")->Arg(1)->Arg(0)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+/**
+ * @brief One full TelemetryModel tick; args are (drones, tick threads: 0 = one per core)
+ */
+void BM_FleetTick(benchmark::State& state)
+{
+    TelemetryModel model;
+    model.setSeed(BENCHMARK_SEED);
+    model.setThreadCount(static_cast<int>(state.range(1)));
+    model.resizeFleet(static_cast<int>(state.range(0)));
+    double dt = MovementStrategy::REFERENCE_STEP_SECONDS;
+
+    for (auto _ : state)
+    {
+        model.updateTelemetry(dt);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0)); // Drone-ticks
+}
+BENCHMARK(BM_FleetTick)
+    ->ArgNames({"drones", "threads"})
+    ->Args({1000, 1})
+    ->Args({1000, 0})
+    ->Args({10000, 1})
+    ->Args({10000, 0})
+    ->Args({100000, 1})
+    ->Args({100000, 0})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+/**
+ * @brief Random-walk fleet tick, whose noise draws dominate the hover strategy's
+ */
+void BM_FleetTick_RandomWalk(benchmark::State& state)
+{
+    TelemetryModel model;
+    model.setSeed(BENCHMARK_SEED);
+    model.setThreadCount(static_cast<int>(state.range(1)));
+    model.setMovementStrategy(new RandomWalkStrategy(&model));
+    model.resizeFleet(static_cast<int>(state.range(0)));
+    double dt = MovementStrategy::REFERENCE_STEP_SECONDS;
+
+    for (auto _ : state)
+    {
+        model.updateTelemetry(dt);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FleetTick_RandomWalk)
+    ->ArgNames({"drones", "threads"})
+    ->Args({1000, 0})
+    ->Args({10000, 0})
+    ->Args({100000, 0})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+}
+
+int main(int argc, char** argv)
+{
+    // The logger needs an application for its log directory
+    QCoreApplication app(argc, argv);
+    qInstallMessageHandler(discardMessages);
+
+    Logger::setMinimumLevel(Logger::INFO);
+    Logger::getInstance().enableAsync();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    Logger::getInstance().disableAsync();
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include "counterrng.h"
+#include "kinematics.h"
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define COUNTERRNG_X86 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+// Philox4x32 multipliers and Weyl key increments (Salmon et al., Random123)
+constexpr quint32 PHILOX_M0 = 0xD2511F53u;
+constexpr quint32 PHILOX_M1 = 0xCD9E8D57u;
+constexpr quint32 PHILOX_W0 = 0x9E3779B9u;
+constexpr quint32 PHILOX_W1 = 0xBB67AE85u;
+constexpr int PHILOX_ROUNDS = 10;
+
+// Drones are sampled in blocks: 8 Philox instances x 4 output words
+constexpr int BLOCK_INSTANCES = 8;
+constexpr int BLOCK_SIZE = BLOCK_INSTANCES * 4;
+
+inline quint32 boundedSample(quint32 word, quint32 bound)
+{
+    // Multiply-shift mapping to [0, bound)
+    return static_cast<quint32>((static_cast<quint64>(word) * bound) >> 32);
+}
+
+// Output word w of instance j lands at block position w * 8 + j, which is what
+// the AVX2 path produces by storing each counter word vector contiguously.
+void generateBlockScalar(double* block, quint32 bound, const quint32 key[2],
+                         quint32 blockIndex, quint32 stream, quint64 tick)
+{
+    for (int j = 0; j < BLOCK_INSTANCES; ++j)
+    {
+        quint32 counter[4] = {
+            blockIndex * BLOCK_INSTANCES + static_cast<quint32>(j),
+            stream,
+            static_cast<quint32>(tick),
+            static_cast<quint32>(tick >> 32)
+        };
+        CounterRng::philox(counter, key);
+        for (int w = 0; w < 4; ++w)
+        {
+            block[w * BLOCK_INSTANCES + j] = boundedSample(counter[w], bound);
+        }
+    }
+}
+
+#ifdef COUNTERRNG_X86
+__attribute__((target("avx2")))
+inline void mulHiLo(__m256i a, __m256i m, __m256i& hi, __m256i& lo)
+{
+    __m256i even = _mm256_mul_epu32(a, m);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+    lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+
+__attribute__((target("avx2")))
+inline void storeBounded(double* out, __m256i words, __m256i bound)
+{
+    __m256i hi;
+    __m256i lo;
+    mulHiLo(words, bound, hi, lo);
+    _mm256_storeu_pd(out, _mm256_cvtepi32_pd(_mm256_castsi256_si128(hi)));
+    _mm256_storeu_pd(out + 4, _mm256_cvtepi32_pd(_mm256_extracti128_si256(hi, 1)));
+}
+
+__attribute__((target("avx2")))
+void generateBlockAvx2(double* block, quint32 bound, const quint32 key[2],
+                       quint32 blockIndex, quint32 stream, quint64 tick)
+{
+    const __m256i m0 = _mm256_set1_epi32(static_cast<int>(PHILOX_M0));
+    const __m256i m1 = _mm256_set1_epi32(static_cast<int>(PHILOX_M1));
+    __m256i c0 = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(blockIndex * BLOCK_INSTANCES)),
+                                  _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256i c1 = _mm256_set1_epi32(static_cast<int>(stream));
+    __m256i c2 = _mm256_set1_epi32(static_cast<int>(static_cast<quint32>(tick)));
+    __m256i c3 = _mm256_set1_epi32(static_cast<int>(static_cast<quint32>(tick >> 32)));
+    quint32 k0 = key[0];
+    quint32 k1 = key[1];
+    
+    for (int round = 0; round < PHILOX_ROUNDS; ++round)
+    {
+        __m256i hi0;
+        __m256i lo0;
+        __m256i hi1;
+        __m256i lo1;
+        mulHiLo(c0, m0, hi0, lo0);
+        mulHiLo(c2, m1, hi1, lo1);
+        c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(static_cast<int>(k0)));
+        c1 = lo1;
+        c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(static_cast<int>(k1)));
+        c3 = lo0;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    
+    const __m256i vBound = _mm256_set1_epi32(static_cast<int>(bound));
+    storeBounded(block, c0, vBound);
+    storeBounded(block + BLOCK_INSTANCES, c1, vBound);
+    storeBounded(block + 2 * BLOCK_INSTANCES, c2, vBound);
+    storeBounded(block + 3 * BLOCK_INSTANCES, c3, vBound);
+}
+#endif // COUNTERRNG_X86
+
+using GenerateBlockFn = void (*)(double*, quint32, const quint32*, quint32, quint32, quint64);
+
+GenerateBlockFn selectGenerateBlock()
+{
+#ifdef COUNTERRNG_X86
+    if (Kinematics::bestSupportedIsa() == Kinematics::Isa::AVX2)
+    {
+        return generateBlockAvx2;
+    }
+#endif
+    return generateBlockScalar;
+}
+}
+
+void CounterRng::philox(quint32 counter[4], const quint32 key[2])
+{
+    quint32 k0 = key[0];
+    quint32 k1 = key[1];
+    
+    for (int round = 0; round < PHILOX_ROUNDS; ++round)
+    {
+        quint64 product0 = static_cast<quint64>(PHILOX_M0) * counter[0];
+        quint64 product1 = static_cast<quint64>(PHILOX_M1) * counter[2];
+        quint32 c1 = counter[1];
+        quint32 c3 = counter[3];
+        counter[0] = static_cast<quint32>(product1 >> 32) ^ c1 ^ k0;
+        counter[1] = static_cast<quint32>(product1);
+        counter[2] = static_cast<quint32>(product0 >> 32) ^ c3 ^ k1;
+        counter[3] = static_cast<quint32>(product0);
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+}
+
+void CounterRng::fillUniform(double* samples, int count, quint32 bound,
+                             quint64 tick, quint32 firstIndex, quint32 stream) const
+{
+    static const GenerateBlockFn generateBlock = selectGenerateBlock();
+    const quint32 key[2] = { static_cast<quint32>(_seed), static_cast<quint32>(_seed >> 32) };
+    double block[BLOCK_SIZE];
+    
+    int filled = 0;
+    while (filled < count)
+    {
+        quint32 index = firstIndex + static_cast<quint32>(filled);
+        quint32 blockIndex = index / BLOCK_SIZE;
+        int offset = static_cast<int>(index % BLOCK_SIZE);
+        int take = qMin(BLOCK_SIZE - offset, count - filled);
+        
+        if (offset == 0 && take == BLOCK_SIZE)
+        {
+            // Whole block: generate straight into the output
+            generateBlock(samples + filled, bound, key, blockIndex, stream, tick);
+        }
+        else
+        {
+            generateBlock(block, bound, key, blockIndex, stream, tick);
+            std::memcpy(samples + filled, block + offset, static_cast<size_t>(take) * sizeof(double));
+        }
+        filled += take;
+    }
+}
+
+quint32 CounterRng::uniform(quint32 bound, quint64 tick, quint32 index, quint32 stream) const
+{
+    double sample = 0.0;
+    fillUniform(&sample, 1, bound, tick, index, stream);
+    return static_cast<quint32>(sample);
+}
@@ -1,136 +1,203 @@
 #include "drone.h"
 #include "logger.h"
-#include <QRandomGenerator>
 
-Drone::Drone(const QString& id, QObject* parent)
+Drone::Drone(const QString& name, QObject* parent)
     : QObject(parent)
-    , _id(id)
-    , _latitude(28.6139) // Default to New Delhi coordinates
-    , _longitude(77.2090)
-    , _altitude(100.0)
-    , _heading(0.0)
-    , _speed(0.0)
-    , _battery(100)
-    , _gpsFixStatus(GPSFixStatus::FIX_3D)
-    , _failureMode(false)
+    , _ownedFleet(new FleetState())
+    , _fleet(_ownedFleet.get())
+    , _index(_fleet->addDrone(name)) // Defaults to New Delhi coordinates
+    , _updateDepth(0)
+    , _pendingFields(TelemetryField::NONE)
 {
     LOG_INFO(QString("Drone %1 created with initial position: lat=%2, lon=%3, alt=%4")
-             .arg(_id)
-             .arg(_latitude, 0, 'f', 6)
-             .arg(_longitude, 0, 'f', 6)
-             .arg(_altitude, 0, 'f', 1));
+             .arg(name)
+             .arg(getLatitude(), 0, 'f', 6)
+             .arg(getLongitude(), 0, 'f', 6)
+             .arg(getAltitude(), 0, 'f', 1));
+}
+
+Drone::Drone(FleetState* fleet, int index, QObject* parent)
+    : QObject(parent)
+    , _fleet(fleet)
+    , _index(index)
+    , _updateDepth(0)
+    , _pendingFields(TelemetryField::NONE)
+{
+    LOG_INFO(QString("Drone %1 attached to fleet slot %2 at position: lat=%3, lon=%4, alt=%5")
+             .arg(getName())
+             .arg(_index)
+             .arg(getLatitude(), 0, 'f', 6)
+             .arg(getLongitude(), 0, 'f', 6)
+             .arg(getAltitude(), 0, 'f', 1));
+}
+
+Drone::~Drone() = default;
+
+void Drone::attach(FleetState* fleet, int index)
+{
+    if (fleet != _fleet)
+    {
+        _ownedFleet.reset(); // A standalone drone's private fleet is no longer needed
+    }
+    _fleet = fleet;
+    _index = index;
+    _updateDepth = 0;
+    _pendingFields = TelemetryField::NONE;
+}
+
+void Drone::beginUpdate()
+{
+    ++_updateDepth;
+}
+
+void Drone::markChanged(quint32 fields)
+{
+    _pendingFields |= fields;
+    
+    if (_updateDepth == 0 && _pendingFields != TelemetryField::NONE)
+    {
+        quint32 changedFields = _pendingFields;
+        _pendingFields = TelemetryField::NONE;
+        emit telemetryUpdated(changedFields);
+    }
+}
+
+void Drone::commitUpdate()
+{
+    if (_updateDepth > 0 && --_updateDepth == 0)
+    {
+        markChanged(TelemetryField::NONE);
+    }
 }
 
 void Drone::setLatitude(double latitude)
 {
-    if (_latitude != latitude)
+    double& current = _fleet->latitudes()[_index];
+    if (current != latitude)
     {
-        _latitude = latitude;
-        emit telemetryUpdated();
+        current = latitude;
+        markChanged(TelemetryField::LATITUDE);
     }
 }
 
 void Drone::setLongitude(double longitude)
 {
-    if (_longitude != longitude)
+    double& current = _fleet->longitudes()[_index];
+    if (current != longitude)
     {
-        _longitude = longitude;
-        emit telemetryUpdated();
+        current = longitude;
+        markChanged(TelemetryField::LONGITUDE);
     }
 }
 
 void Drone::setAltitude(double altitude)
 {
-    if (_altitude != altitude)
+    double& current = _fleet->altitudes()[_index];
+    if (current != altitude)
     {
-        _altitude = altitude;
-        emit telemetryUpdated();
+        current = altitude;
+        markChanged(TelemetryField::ALTITUDE);
     }
 }
 
 void Drone::setHeading(double heading)
 {
-    if (_heading != heading)
+    double& current = _fleet->headings()[_index];
+    if (current != heading)
     {
-        _heading = heading;
-        emit telemetryUpdated();
+        current = heading;
+        markChanged(TelemetryField::HEADING);
     }
 }
 
 void Drone::setSpeed(double speed)
 {
-    if (_speed != speed)
+    double& current = _fleet->speeds()[_index];
+    if (current != speed)
     {
-        _speed = speed;
-        emit telemetryUpdated();
+        current = speed;
+        markChanged(TelemetryField::SPEED);
     }
 }
 
 void Drone::setBattery(int battery)
 {
-    if (_battery != battery)
+    int& current = _fleet->batteries()[_index];
+    if (current != battery)
     {
-        int oldBattery = _battery;
-        _battery = qBound(0, battery, 100);
+        int oldBattery = current;
+        current = qBound(0, battery, 100);
         
-        if (_battery <= 20 && oldBattery > 20)
+        if (current <= 20 && oldBattery > 20)
         {
-            emit batteryLow(_battery);
-            LOG_WARNING(QString("Drone %1 battery low: %2%").arg(_id).arg(_battery));
+            emit batteryLow(current);
+            LOG_WARNING(QString("Drone %1 battery low: %2%").arg(getName()).arg(current));
         }
         
-        emit telemetryUpdated();
+        markChanged(TelemetryField::BATTERY);
     }
 }
 
 void Drone::setGpsFixStatus(GPSFixStatus status)
 {
-    if (_gpsFixStatus != status)
+    GPSFixStatus& current = _fleet->gpsFixStatuses()[_index];
+    if (current != status)
     {
-        GPSFixStatus oldStatus = _gpsFixStatus;
-        _gpsFixStatus = status;
+        GPSFixStatus oldStatus = current;
+        current = status;
         
         if (oldStatus != GPSFixStatus::NO_FIX && status == GPSFixStatus::NO_FIX)
         {
             emit gpsFixLost();
-            LOG_WARNING(QString("Drone %1 GPS fix lost").arg(_id));
+            LOG_WARNING(QString("Drone %1 GPS fix lost").arg(getName()));
         }
         
-        emit telemetryUpdated();
+        markChanged(TelemetryField::GPS_FIX);
     }
 }
 
-void Drone::drainBattery()
+void Drone::drainBattery(double dt)
 {
-    int drainAmount = _failureMode ? 5 : 1; // Faster drain in failure mode
-    setBattery(_battery - drainAmount);
+    // Faster drain in failure mode
+    int drainAmount = accumulateDrain(_fleet->failureModes()[_index], dt, _fleet->batteryDrains()[_index]);
+    if (drainAmount > 0)
+    {
+        setBattery(getBattery() - drainAmount);
+    }
 }
 
 void Drone::simulateFailure()
 {
-    if (!_failureMode)
+    quint8& failureMode = _fleet->failureModes()[_index];
+    if (!failureMode)
     {
-        _failureMode = true;
+        failureMode = 1;
         setGpsFixStatus(GPSFixStatus::NO_FIX);
-        LOG_WARNING(QString("Drone %1 failure mode activated").arg(_id));
+        LOG_WARNING(QString("Drone %1 failure mode activated").arg(getName()));
         emit failureSimulated();
     }
 }
 
 void Drone::resetFailure()
 {
-    if (_failureMode)
+    quint8& failureMode = _fleet->failureModes()[_index];
+    if (failureMode)
     {
-        _failureMode = false;
+        failureMode = 0;
         setGpsFixStatus(GPSFixStatus::FIX_3D);
-        LOG_INFO(QString("Drone %1 failure mode reset").arg(_id));
+        LOG_INFO(QString("Drone %1 failure mode reset").arg(getName()));
         emit failureReset();
     }
 }
 
 QString Drone::getGpsFixStatusString() const
 {
-    switch (_gpsFixStatus)
+    return gpsFixStatusToString(getGpsFixStatus());
+}
+
+QString Drone::gpsFixStatusToString(GPSFixStatus status)
+{
+    switch (status)
     {
     case GPSFixStatus::NO_FIX:
         return "No Fix";
@@ -1,6 +1,39 @@
 #include "dronefactory.h"
 #include "drone.h"
+#include "dronenametable.h"
+#include "dronepool.h"
+#include "fleetstate.h"
 #include "logger.h"
+#include "counterrng.h"
+#include "movementstrategy.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSet>
+#include <QTextStream>
+#include <QVector>
+#include <QtMath>
+
+namespace
+{
+constexpr double METRES_PER_DEGREE = 111320.0;   // Metres per degree of latitude (and of longitude at the equator)
+constexpr quint32 UNIFORM_RESOLUTION = 1u << 24; // Distinct values per random disk coordinate
+
+/**
+ * @brief Generated ID: prefix + zero-padded number
+ */
+QString generatedId(const QString& prefix, int number)
+{
+    return prefix + QString("%1").arg(number, 3, 10, QChar('0'));
+}
+
+/**
+ * @brief Degrees of longitude per metre east at a latitude
+ */
+double longitudeDegreesPerMetre(double latitude)
+{
+    return 1.0 / (METRES_PER_DEGREE * qMax(1e-6, std::cos(qDegreesToRadians(latitude))));
+}
+}
 
 DroneFactory::DroneFactory(QObject* parent)
     : QObject(parent)
@@ -32,4 +65,322 @@ Drone* DroneFactory::createDrone(const QString& id,
     drone->setAltitude(altitude);
     
     return drone;
-} 
\ No newline at end of file
+}
+
+Drone* DroneFactory::createDrone(FleetState* fleet,
+                                 const QString& id,
+                                 QObject* parent)
+{
+    if (!fleet)
+    {
+        return createDrone(id, parent);
+    }
+    
+    LOG_INFO(QString("Creating drone with ID: %1 in fleet slot %2").arg(id).arg(fleet->size()));
+    int index = fleet->addDrone(id);
+    return new Drone(fleet, index, parent);
+}
+
+Drone* DroneFactory::acquireDrone(DronePool* pool,
+                                  FleetState* fleet,
+                                  const QString& id)
+{
+    if (!pool || !fleet)
+    {
+        LOG_WARNING(QString("Cannot create drone %1 without a pool and a fleet").arg(id));
+        return nullptr;
+    }
+    
+    LOG_DEBUG(QString("Creating pooled drone with ID: %1 in fleet slot %2").arg(id).arg(fleet->size()));
+    int index = fleet->addDrone(id);
+    return pool->acquire(fleet, index);
+}
+
+int DroneFactory::spawnDrones(FleetState* fleet, const SpawnDescriptor& descriptor, int* nextNumber,
+                              QVector<DroneId>* freeIds)
+{
+    if (!fleet)
+    {
+        LOG_WARNING("Cannot spawn drones without a fleet");
+        return 0;
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    int first = fleet->size();
+    int count = 0;
+    int number = descriptor.firstNumber;
+    QString pattern;
+    switch (descriptor.pattern)
+    {
+    case SpawnDescriptor::GRID_PATTERN:
+        count = qMax(0, descriptor.count);
+        first = fleet->addDrones(count);
+        placeGrid(fleet, first, count, descriptor);
+        count = assignSpawnIds(fleet, first, count, descriptor.idPrefix, &number, freeIds);
+        pattern = QString("grid, %1 m spacing").arg(descriptor.spacing);
+        break;
+    case SpawnDescriptor::RANDOM_DISK_PATTERN:
+        count = qMax(0, descriptor.count);
+        first = fleet->addDrones(count);
+        placeRandomDisk(fleet, first, count, descriptor);
+        count = assignSpawnIds(fleet, first, count, descriptor.idPrefix, &number, freeIds);
+        pattern = QString("random disk, %1 m radius").arg(descriptor.radius);
+        break;
+    case SpawnDescriptor::FILE_PATTERN:
+        count = qMax(0, spawnFromFile(fleet, descriptor));
+        pattern = QString("from %1").arg(descriptor.filePath);
+        break;
+    }
+    
+    LOG_INFO(QString("Spawned %1 drones (%2) into fleet slots %3-%4 in %5 ms")
+             .arg(count)
+             .arg(pattern)
+             .arg(first)
+             .arg(first + count - 1)
+             .arg(timer.nsecsElapsed() / 1e6, 0, 'f', 2));
+    if (nextNumber)
+    {
+        *nextNumber = number;
+    }
+    return count;
+}
+
+int DroneFactory::assignGeneratedIds(FleetState* fleet, int first, int count, const QString& prefix,
+                                     int* nextNumber, QVector<DroneId>* freeIds)
+{
+    DroneNameTable& names = DroneNameTable::getInstance();
+    int assigned = 0;
+    
+    // Despawned drones' IDs come back first, oldest first, so churn does not grow the
+    // name table; IDs that are live again or carry another prefix are just dropped
+    while (freeIds && assigned < count && !freeIds->isEmpty())
+    {
+        DroneId id = freeIds->takeFirst();
+        if (fleet->slotOf(id) < 0 && names.name(id).startsWith(prefix))
+        {
+            fleet->setId(first + assigned++, id);
+        }
+    }
+    
+    // Then fresh numbers: they only ever grow, so a batch never repeats itself or an
+    // earlier batch; names a live drone already holds are dropped and the rest retried
+    int number = *nextNumber;
+    QVector<QString> batch;
+    QVector<DroneId> batchIds;
+    while (assigned < count)
+    {
+        int wanted = count - assigned;
+        batch.clear();
+        batch.reserve(wanted);
+        for (int i = 0; i < wanted; ++i)
+        {
+            batch.append(generatedId(prefix, number + i));
+        }
+        batchIds.resize(wanted);
+        names.internAll(batch.constData(), wanted, batchIds.data());
+        for (int i = 0; i < wanted; ++i)
+        {
+            if (batchIds[i] == DroneNameTable::INVALID_DRONE_ID)
+            {
+                // The table is full; this number was not used and may be tried again later
+                *nextNumber = number + i;
+                return assigned;
+            }
+            if (fleet->slotOf(batchIds[i]) < 0)
+            {
+                fleet->setId(first + assigned++, batchIds[i]);
+            }
+        }
+        number += wanted;
+    }
+    *nextNumber = number;
+    return assigned;
+}
+
+int DroneFactory::assignSpawnIds(FleetState* fleet, int first, int count, const QString& prefix,
+                                 int* nextNumber, QVector<DroneId>* freeIds)
+{
+    int assigned = assignGeneratedIds(fleet, first, count, prefix, nextNumber, freeIds);
+    if (assigned < count)
+    {
+        // Drop the drones left without an ID, from the end so no other drone moves
+        for (int slot = first + count; slot-- > first + assigned;)
+        {
+            fleet->removeDrone(slot);
+        }
+        LOG_ERROR(QString("Spawned only %1 of %2 drones: the drone name table is full").arg(assigned).arg(count));
+    }
+    return assigned;
+}
+
+SpawnDescriptor::Pattern DroneFactory::spawnPatternFromName(const QString& name, bool* ok)
+{
+    if (ok)
+    {
+        *ok = true;
+    }
+    if (name == "grid")
+    {
+        return SpawnDescriptor::GRID_PATTERN;
+    }
+    if (name == "disk")
+    {
+        return SpawnDescriptor::RANDOM_DISK_PATTERN;
+    }
+    if (name == "file")
+    {
+        return SpawnDescriptor::FILE_PATTERN;
+    }
+    if (ok)
+    {
+        *ok = false;
+    }
+    return SpawnDescriptor::GRID_PATTERN;
+}
+
+void DroneFactory::placeGrid(FleetState* fleet, int first, int count, const SpawnDescriptor& descriptor)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    
+    int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+    int rows = (count + columns - 1) / columns;
+    double latitudeStep = descriptor.spacing / METRES_PER_DEGREE;
+    double longitudeStep = descriptor.spacing * longitudeDegreesPerMetre(descriptor.latitude);
+    double* latitudes = fleet->latitudes() + first;
+    double* longitudes = fleet->longitudes() + first;
+    double* altitudes = fleet->altitudes() + first;
+    
+    for (int i = 0; i < count; ++i)
+    {
+        int row = i / columns;
+        int column = i % columns;
+        latitudes[i] = descriptor.latitude + (row - (rows - 1) / 2.0) * latitudeStep;
+        longitudes[i] = descriptor.longitude + (column - (columns - 1) / 2.0) * longitudeStep;
+        altitudes[i] = descriptor.altitude;
+    }
+}
+
+void DroneFactory::placeRandomDisk(FleetState* fleet, int first, int count, const SpawnDescriptor& descriptor)
+{
+    // Keyed by seed and slot, so the same descriptor always gives the same swarm. The spawn
+    // streams keep placement apart from the movement noise drawn with the same seed
+    CounterRng rng(descriptor.seed);
+    double longitudeScale = longitudeDegreesPerMetre(descriptor.latitude);
+    double* latitudes = fleet->latitudes() + first;
+    double* longitudes = fleet->longitudes() + first;
+    double* altitudes = fleet->altitudes() + first;
+    
+    for (int i = 0; i < count; ++i)
+    {
+        quint32 slot = static_cast<quint32>(first + i);
+        double u = static_cast<double>(rng.uniform(UNIFORM_RESOLUTION, 0, slot, MovementStrategy::SPAWN_DISTANCE_STREAM)) /
+                   UNIFORM_RESOLUTION;
+        double v = static_cast<double>(rng.uniform(UNIFORM_RESOLUTION, 0, slot, MovementStrategy::SPAWN_BEARING_STREAM)) /
+                   UNIFORM_RESOLUTION;
+        
+        // sqrt keeps the density uniform over the disk's area rather than its radius
+        double distance = descriptor.radius * std::sqrt(u);
+        double bearing = 2.0 * M_PI * v;
+        latitudes[i] = descriptor.latitude + distance * std::cos(bearing) / METRES_PER_DEGREE;
+        longitudes[i] = descriptor.longitude + distance * std::sin(bearing) * longitudeScale;
+        altitudes[i] = descriptor.altitude;
+    }
+}
+
+int DroneFactory::spawnFromFile(FleetState* fleet, const SpawnDescriptor& descriptor)
+{
+    QFile file(descriptor.filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        LOG_ERROR(QString("Failed to open spawn file %1: %2").arg(descriptor.filePath, file.errorString()));
+        return -1;
+    }
+    
+    // Parse everything first so the fleet grows in one step
+    QVector<QString> names;
+    QVector<double> positions; // latitude, longitude, altitude per drone
+    int skippedLines = 0;
+    QTextStream in(&file);
+    while (!in.atEnd())
+    {
+        QString line = in.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#'))
+        {
+            continue;
+        }
+        
+        QStringList fields = line.split(',');
+        bool latitudeOk = false;
+        bool longitudeOk = false;
+        bool altitudeOk = true;
+        double latitude = fields.size() >= 3 ? fields[1].trimmed().toDouble(&latitudeOk) : 0.0;
+        double longitude = fields.size() >= 3 ? fields[2].trimmed().toDouble(&longitudeOk) : 0.0;
+        double altitude = fields.size() >= 4 ? fields[3].trimmed().toDouble(&altitudeOk) : descriptor.altitude;
+        if (!latitudeOk || !longitudeOk || !altitudeOk || fields[0].trimmed().isEmpty())
+        {
+            ++skippedLines; // Also skips a header row
+            continue;
+        }
+        
+        names.append(fields[0].trimmed());
+        positions.append(latitude);
+        positions.append(longitude);
+        positions.append(altitude);
+    }
+    
+    if (skippedLines > 0)
+    {
+        LOG_WARNING(QString("Skipped %1 unreadable line(s) in spawn file %2").arg(skippedLines).arg(descriptor.filePath));
+    }
+    
+    // Two drones with one name would share a DroneId; keep the first of each name.
+    // Only the file's own IDs are collected; live drones are looked up by ID.
+    QVector<DroneId> fileIds(names.size());
+    int unnamed = DroneNameTable::getInstance().internAll(names.constData(), names.size(), fileIds.data());
+    QSet<DroneId> seen;
+    seen.reserve(names.size());
+    QVector<int> kept;
+    kept.reserve(names.size());
+    for (int line = 0; line < names.size(); ++line)
+    {
+        DroneId id = fileIds[line];
+        if (id != DroneNameTable::INVALID_DRONE_ID && fleet->slotOf(id) < 0 && !seen.contains(id))
+        {
+            seen.insert(id);
+            kept.append(line);
+        }
+    }
+    
+    if (unnamed > 0)
+    {
+        LOG_ERROR(QString("Skipped %1 line(s) in spawn file %2: the drone name table is full")
+                  .arg(unnamed)
+                  .arg(descriptor.filePath));
+    }
+    if (kept.size() + unnamed < names.size())
+    {
+        LOG_WARNING(QString("Skipped %1 line(s) with an ID already in use in spawn file %2")
+                    .arg(names.size() - unnamed - kept.size())
+                    .arg(descriptor.filePath));
+    }
+    
+    int count = kept.size();
+    int first = fleet->addDrones(count);
+    double* latitudes = fleet->latitudes() + first;
+    double* longitudes = fleet->longitudes() + first;
+    double* altitudes = fleet->altitudes() + first;
+    for (int i = 0; i < count; ++i)
+    {
+        int line = kept[i];
+        fleet->setId(first + i, fileIds[line]);
+        latitudes[i] = positions[3 * line];
+        longitudes[i] = positions[3 * line + 1];
+        altitudes[i] = positions[3 * line + 2];
+    }
+    return count;
+}
@@ -0,0 +1,81 @@
+#include "dronenametable.h"
+#include "logger.h"
+
+DroneNameTable& DroneNameTable::getInstance()
+{
+    // Never destroyed, so names stay valid for threads still running at exit
+    static DroneNameTable* instance = new DroneNameTable();
+    return *instance;
+}
+
+DroneNameTable::DroneNameTable()
+    : _count(0)
+    , _capacity(MAX_NAMES)
+{
+    for (QString*& segment : _segments)
+    {
+        segment = nullptr;
+    }
+}
+
+DroneId DroneNameTable::intern(const QString& name)
+{
+    QMutexLocker locker(&_mutex);
+    DroneId id = internLocked(name);
+    if (id == INVALID_DRONE_ID)
+    {
+        LOG_ERROR(QString("Drone name table is full (%1 names); cannot intern %2").arg(_capacity).arg(name));
+    }
+    return id;
+}
+
+int DroneNameTable::internAll(const QString* names, int count, DroneId* ids)
+{
+    QMutexLocker locker(&_mutex);
+    _ids.reserve(_ids.size() + count);
+    int failed = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        ids[i] = internLocked(names[i]);
+        failed += ids[i] == INVALID_DRONE_ID ? 1 : 0;
+    }
+    if (failed > 0)
+    {
+        LOG_ERROR(QString("Drone name table is full (%1 names); cannot intern %2 of %3 names")
+                  .arg(_capacity).arg(failed).arg(count));
+    }
+    return failed;
+}
+
+void DroneNameTable::setCapacity(int capacity)
+{
+    QMutexLocker locker(&_mutex);
+    quint32 count = _count.load(std::memory_order_relaxed);
+    _capacity = qBound(count, static_cast<quint32>(qMax(capacity, 0)), static_cast<quint32>(MAX_NAMES));
+}
+
+DroneId DroneNameTable::internLocked(const QString& name)
+{
+    DroneId existing = _ids.value(name, INVALID_DRONE_ID);
+    if (existing != INVALID_DRONE_ID)
+    {
+        return existing;
+    }
+
+    quint32 id = _count.load(std::memory_order_relaxed);
+    if (id >= _capacity)
+    {
+        return INVALID_DRONE_ID;
+    }
+    int segment = static_cast<int>(id >> SEGMENT_BITS);
+    if (!_segments[segment])
+    {
+        _segments[segment] = new QString[SEGMENT_SIZE];
+    }
+
+    // Store the name before publishing the new count to lock-free readers
+    _segments[segment][id & (SEGMENT_SIZE - 1)] = name;
+    _ids.insert(name, id);
+    _count.store(id + 1, std::memory_order_release);
+    return id;
+}
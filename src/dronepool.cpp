@@ -0,0 +1,36 @@
+#include "dronepool.h"
+#include "drone.h"
+#include "logger.h"
+
+DronePool::DronePool(QObject* parent)
+    : QObject(parent)
+    , _createdCount(0)
+{
+    LOG_DEBUG("DronePool created");
+}
+
+Drone* DronePool::acquire(FleetState* fleet, int index)
+{
+    if (_free.isEmpty())
+    {
+        ++_createdCount;
+        return new Drone(fleet, index, this);
+    }
+
+    Drone* drone = _free.takeLast();
+    drone->attach(fleet, index);
+    return drone;
+}
+
+void DronePool::release(Drone* drone)
+{
+    if (!drone || drone->parent() != this)
+    {
+        LOG_WARNING("Cannot release a drone that does not belong to the pool");
+        return;
+    }
+
+    // Stale receivers must not hear from the view once it shows another drone
+    drone->disconnect();
+    _free.append(drone);
+}
@@ -7,13 +7,17 @@ DroneSimulator::DroneSimulator(QObject* parent)
     : QObject(parent)
     , _telemetryModel(nullptr)
     , _simulationThread(new QThread(this))
+    , _tickTimer(nullptr)
+    , _timeScale(1.0)
     , _running(false)
 {
     LOG_DEBUG("DroneSimulator created");
     
-    // Move simulator to worker thread
-    moveToThread();
-    connect(_simulationThread, &QThread::started, this, &DroneSimulator::runSimulation);
+    _simulationThread->setObjectName("SimulationThread");
+    
+    // started is emitted from the worker thread; run the entry point there directly
+    connect(_simulationThread, &QThread::started, this, &DroneSimulator::runSimulation,
+            Qt::DirectConnection);
     connect(_simulationThread, &QThread::finished, this, [this]() {
         LOG_DEBUG("Simulation thread finished");
     });
@@ -22,12 +26,7 @@ DroneSimulator::DroneSimulator(QObject* parent)
 DroneSimulator::~DroneSimulator()
 {
     stopSimulation();
-    
-    if (_simulationThread->isRunning())
-    {
-        _simulationThread->quit();
-        _simulationThread->wait();
-    }
+    stopThread();
     
     LOG_DEBUG("DroneSimulator destroyed");
 }
@@ -40,14 +39,14 @@ void DroneSimulator::startSimulation()
     {
         _running = true;
         
-        if (!_simulationThread->isRunning())
+        if (_telemetryModel)
         {
-            _simulationThread->start();
+            _telemetryModel->startSimulation();
         }
         
-        if (_telemetryModel)
+        if (!_simulationThread->isRunning())
         {
-            _telemetryModel->startSimulation();
+            _simulationThread->start();
         }
         
         LOG_INFO("DroneSimulator simulation started");
@@ -62,6 +61,10 @@ void DroneSimulator::stopSimulation()
     if (_running)
     {
         _running = false;
+        locker.unlock();
+        
+        // Join the worker first so no tick is in flight once we report stopped
+        stopThread();
         
         if (_telemetryModel)
         {
@@ -100,13 +103,106 @@ void DroneSimulator::setTelemetryModel(TelemetryModel* model)
     }
 }
 
+void DroneSimulator::setTimeScale(double timeScale)
+{
+    double clamped = qBound(FixedStepScheduler::MIN_TIME_SCALE, timeScale,
+                            FixedStepScheduler::MAX_TIME_SCALE);
+    if (_timeScale.exchange(clamped, std::memory_order_relaxed) != clamped)
+    {
+        LOG_INFO(QString("Simulation time scale set to %1x").arg(clamped));
+        emit timeScaleChanged(clamped);
+    }
+}
+
+void DroneSimulator::setTimeStep(double stepSeconds)
+{
+    QMutexLocker locker(&_mutex);
+    
+    if (_simulationThread->isRunning())
+    {
+        LOG_WARNING("Cannot change the simulation time step while the simulation is running");
+        return;
+    }
+    
+    _scheduler.setStepSeconds(stepSeconds);
+    LOG_INFO(QString("Simulation time step set to %1 s").arg(_scheduler.getStepSeconds()));
+}
+
 void DroneSimulator::runSimulation()
 {
     LOG_DEBUG("Simulation thread started");
     
-    // This method runs in the worker thread
-    // The actual simulation is handled by the TelemetryModel timer
-    // This thread just manages the simulation lifecycle
+    _scheduler.setTimeScale(getTimeScale());
+    updateTickBudget();
+    _wallClock.start();
+    _scheduler.start(_wallClock.nsecsElapsed());
+    
+    // This method runs in the worker thread: the timer created here has
+    // worker-thread affinity, so its timeouts (and every tick) run there too.
+    // The timer only wakes the worker; the scheduler decides how many steps are due.
+    _tickTimer = new QTimer();
+    _tickTimer->setTimerType(Qt::PreciseTimer);
+    _tickTimer->setInterval(_scheduler.getWakeIntervalMs());
+    
+    connect(_tickTimer, &QTimer::timeout, _tickTimer, [this]() {
+        onTick();
+    });
+    connect(_simulationThread, &QThread::finished, _tickTimer, &QObject::deleteLater);
+    
+    _tickTimer->start();
+}
+
+void DroneSimulator::onTick()
+{
+    quint64 droppedBefore = _scheduler.getDroppedSteps();
+    int dueSteps = _scheduler.advance(_wallClock.nsecsElapsed());
+    
+    // Time up to now was accounted at the old scale; a new scale applies from here on
+    double timeScale = getTimeScale();
+    if (timeScale != _scheduler.getTimeScale())
+    {
+        _scheduler.setTimeScale(timeScale);
+        _tickTimer->setInterval(_scheduler.getWakeIntervalMs());
+        updateTickBudget();
+    }
+    
+    if (!_telemetryModel)
+    {
+        return;
+    }
+    
+    TickProfiler* profiler = _telemetryModel->getProfiler();
+    qint64 wakeStart = profiler->now();
+    
+    if (_scheduler.getDroppedSteps() != droppedBefore)
+    {
+        LOG_WARNING(QString("Simulation falling behind: dropped %1 step(s), %2 total")
+                    .arg(_scheduler.getDroppedSteps() - droppedBefore)
+                    .arg(_scheduler.getDroppedSteps()));
+        profiler->lap(TickProfiler::LOGGING_PHASE, wakeStart);
+    }
+    
+    if (dueSteps == 0)
+    {
+        return;
+    }
+    
+    double dt = _scheduler.getStepSeconds();
+    for (int i = 0; i < dueSteps; ++i)
+    {
+        _telemetryModel->updateTelemetry(dt);
+    }
+    profiler->lap(TickProfiler::WAKE_UP_PHASE, wakeStart);
+}
+
+void DroneSimulator::updateTickBudget()
+{
+    // One step must finish in the wall time it represents, or the simulation falls behind
+    if (_telemetryModel)
+    {
+        double budgetSeconds = _scheduler.getStepSeconds() / _scheduler.getTimeScale();
+        _telemetryModel->getProfiler()->setTickBudget(static_cast<qint64>(budgetSeconds * 1e9));
+    }
 }
 
 void DroneSimulator::onModelTelemetryUpdated()
@@ -115,7 +211,12 @@ void DroneSimulator::onModelTelemetryUpdated()
     // This could be used for additional processing if needed
 }
 
-void DroneSimulator::moveToThread()
+void DroneSimulator::stopThread()
 {
-    QObject::moveToThread(_simulationThread);
+    if (_simulationThread->isRunning())
+    {
+        _simulationThread->quit();
+        _simulationThread->wait();
+    }
+    _tickTimer = nullptr;
 } 
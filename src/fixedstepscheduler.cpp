@@ -0,0 +1,63 @@
+#include "fixedstepscheduler.h"
+#include <cmath>
+
+FixedStepScheduler::FixedStepScheduler(double stepSeconds, int maxCatchUpSteps)
+    : _stepSeconds(0.5)
+    , _timeScale(1.0)
+    , _maxCatchUpSteps(1)
+    , _lastWallNs(0)
+    , _accumulatedSeconds(0.0)
+    , _droppedSteps(0)
+{
+    setStepSeconds(stepSeconds);
+    setMaxCatchUpSteps(maxCatchUpSteps);
+}
+
+void FixedStepScheduler::setStepSeconds(double stepSeconds)
+{
+    if (stepSeconds > 0.0)
+    {
+        _stepSeconds = stepSeconds;
+    }
+}
+
+void FixedStepScheduler::setTimeScale(double timeScale)
+{
+    _timeScale = qBound(MIN_TIME_SCALE, timeScale, MAX_TIME_SCALE);
+}
+
+void FixedStepScheduler::setMaxCatchUpSteps(int maxCatchUpSteps)
+{
+    _maxCatchUpSteps = qMax(1, maxCatchUpSteps);
+}
+
+void FixedStepScheduler::start(qint64 wallNs)
+{
+    _lastWallNs = wallNs;
+    _accumulatedSeconds = 0.0;
+}
+
+int FixedStepScheduler::advance(qint64 wallNs)
+{
+    qint64 elapsedNs = qMax<qint64>(0, wallNs - _lastWallNs);
+    _lastWallNs = wallNs;
+    _accumulatedSeconds += elapsedNs * 1e-9 * _timeScale;
+    
+    qint64 due = static_cast<qint64>(std::floor(_accumulatedSeconds / _stepSeconds));
+    if (due > _maxCatchUpSteps)
+    {
+        // Too far behind: give up on the excess instead of spiralling
+        _droppedSteps += static_cast<quint64>(due - _maxCatchUpSteps);
+        due = _maxCatchUpSteps;
+        _accumulatedSeconds = due * _stepSeconds;
+    }
+    _accumulatedSeconds -= due * _stepSeconds;
+    return static_cast<int>(due);
+}
+
+int FixedStepScheduler::getWakeIntervalMs() const
+{
+    // Poll at twice the step rate so timer jitter never delays a step by a full period
+    double stepWallMs = _stepSeconds * 1000.0 / _timeScale;
+    return qMax(1, static_cast<int>(stepWallMs / 2.0));
+}
@@ -0,0 +1,154 @@
+#include "fleetstate.h"
+
+void FleetState::reserve(int count)
+{
+    _ids.reserve(count);
+    _latitudes.reserve(count);
+    _longitudes.reserve(count);
+    _altitudes.reserve(count);
+    _headings.reserve(count);
+    _speeds.reserve(count);
+    _batteries.reserve(count);
+    _batteryDrains.reserve(count);
+    _gpsFixStatuses.reserve(count);
+    _failureModes.reserve(count);
+    _strategyIds.reserve(count);
+}
+
+void FleetState::clear()
+{
+    _ids.clear();
+    _slotOfId.clear();
+    _latitudes.clear();
+    _longitudes.clear();
+    _altitudes.clear();
+    _headings.clear();
+    _speeds.clear();
+    _batteries.clear();
+    _batteryDrains.clear();
+    _gpsFixStatuses.clear();
+    _failureModes.clear();
+    _strategyIds.clear();
+    ++_layoutVersion;
+}
+
+int FleetState::addDrone(const QString& name)
+{
+    return addDrone(name, DEFAULT_LATITUDE, DEFAULT_LONGITUDE, DEFAULT_ALTITUDE);
+}
+
+int FleetState::addDrone(const QString& name, double latitude, double longitude, double altitude)
+{
+    return addDrone(DroneNameTable::getInstance().intern(name), latitude, longitude, altitude);
+}
+
+int FleetState::addDrone(DroneId id, double latitude, double longitude, double altitude)
+{
+    _ids.append(id);
+    _latitudes.append(latitude);
+    _longitudes.append(longitude);
+    _altitudes.append(altitude);
+    _headings.append(0.0);
+    _speeds.append(0.0);
+    _batteries.append(100);
+    _batteryDrains.append(0.0);
+    _gpsFixStatuses.append(GPSFixStatus::FIX_3D);
+    _failureModes.append(0);
+    _strategyIds.append(0);
+    indexSlot(size() - 1);
+    return size() - 1;
+}
+
+int FleetState::addDrones(int count)
+{
+    int first = size();
+    if (count <= 0)
+    {
+        return first;
+    }
+
+    _ids.insert(first, count, DroneNameTable::INVALID_DRONE_ID);
+    _latitudes.insert(first, count, DEFAULT_LATITUDE);
+    _longitudes.insert(first, count, DEFAULT_LONGITUDE);
+    _altitudes.insert(first, count, DEFAULT_ALTITUDE);
+    _headings.insert(first, count, 0.0);
+    _speeds.insert(first, count, 0.0);
+    _batteries.insert(first, count, 100);
+    _batteryDrains.insert(first, count, 0.0);
+    _gpsFixStatuses.insert(first, count, GPSFixStatus::FIX_3D);
+    _failureModes.insert(first, count, quint8(0));
+    _strategyIds.insert(first, count, quint8(0));
+    return first;
+}
+
+int FleetState::removeDrone(int index)
+{
+    int last = size() - 1;
+    if (index < 0 || index > last)
+    {
+        return -1;
+    }
+
+    if (index != last)
+    {
+        _ids[index] = _ids[last];
+        _latitudes[index] = _latitudes[last];
+        _longitudes[index] = _longitudes[last];
+        _altitudes[index] = _altitudes[last];
+        _headings[index] = _headings[last];
+        _speeds[index] = _speeds[last];
+        _batteries[index] = _batteries[last];
+        _batteryDrains[index] = _batteryDrains[last];
+        _gpsFixStatuses[index] = _gpsFixStatuses[last];
+        _failureModes[index] = _failureModes[last];
+        _strategyIds[index] = _strategyIds[last];
+        indexSlot(index);
+    }
+
+    // Shrinking keeps the capacity, so the slot is reused by the next addDrone()
+    _ids.removeLast();
+    _latitudes.removeLast();
+    _longitudes.removeLast();
+    _altitudes.removeLast();
+    _headings.removeLast();
+    _speeds.removeLast();
+    _batteries.removeLast();
+    _batteryDrains.removeLast();
+    _gpsFixStatuses.removeLast();
+    _failureModes.removeLast();
+    _strategyIds.removeLast();
+    ++_layoutVersion;
+    return index != last ? last : -1;
+}
+
+void FleetState::indexSlot(int index)
+{
+    DroneId id = _ids[index];
+    if (id == DroneNameTable::INVALID_DRONE_ID)
+    {
+        return;
+    }
+    if (id >= static_cast<DroneId>(_slotOfId.size()))
+    {
+        _slotOfId.resize(static_cast<int>(id) + 1, -1);
+    }
+    _slotOfId[static_cast<int>(id)] = index;
+}
+
+FleetSlice FleetState::slice(int begin, int count)
+{
+    FleetSlice result;
+    result.begin = begin;
+    result.count = count;
+    result.latitudes = _latitudes.data() + begin;
+    result.longitudes = _longitudes.data() + begin;
+    result.altitudes = _altitudes.data() + begin;
+    result.headings = _headings.data() + begin;
+    result.speeds = _speeds.data() + begin;
+    result.batteries = _batteries.data() + begin;
+    result.batteryDrains = _batteryDrains.data() + begin;
+    result.gpsFixStatuses = _gpsFixStatuses.data() + begin;
+    result.failureModes = _failureModes.data() + begin;
+    result.strategyIds = _strategyIds.data() + begin;
+    return result;
+}
@@ -0,0 +1,307 @@
+#include "fleettablemodel.h"
+#include "drone.h"
+#include <QPair>
+#include <algorithm>
+
+FleetTableModel::FleetTableModel(QObject* parent)
+    : QAbstractTableModel(parent)
+    , _sortColumn(-1)
+    , _sortOrder(Qt::AscendingOrder)
+    , _gpsFixFilter(NO_GPS_FILTER)
+    , _firstVisibleRow(0)
+    , _lastVisibleRow(-1)
+{
+    _idCollator.setNumericMode(true);
+    _sinceSort.start();
+}
+
+int FleetTableModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : _rows.size();
+}
+
+int FleetTableModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : COLUMN_COUNT;
+}
+
+QVariant FleetTableModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= _rows.size())
+    {
+        return QVariant();
+    }
+
+    if (role == Qt::TextAlignmentRole)
+    {
+        bool isText = index.column() == ID_COLUMN || index.column() == GPS_FIX_COLUMN;
+        return static_cast<int>((isText ? Qt::AlignLeft : Qt::AlignRight) | Qt::AlignVCenter);
+    }
+
+    if (role != Qt::DisplayRole)
+    {
+        return QVariant();
+    }
+
+    // Formatted on demand: only the rows on screen are ever asked for
+    int slot = _rows[index.row()];
+    switch (index.column())
+    {
+    case ID_COLUMN:
+        return _fleet.name(slot);
+    case LATITUDE_COLUMN:
+        return QString::number(_fleet.latitudes()[slot], 'f', 6);
+    case LONGITUDE_COLUMN:
+        return QString::number(_fleet.longitudes()[slot], 'f', 6);
+    case ALTITUDE_COLUMN:
+        return QString::number(_fleet.altitudes()[slot], 'f', 1);
+    case HEADING_COLUMN:
+        return QString::number(_fleet.headings()[slot], 'f', 1);
+    case SPEED_COLUMN:
+        return QString::number(_fleet.speeds()[slot], 'f', 1);
+    case BATTERY_COLUMN:
+        return QString("%1%").arg(_fleet.batteries()[slot]);
+    case GPS_FIX_COLUMN:
+        return Drone::gpsFixStatusToString(_fleet.gpsFixStatuses()[slot]);
+    default:
+        return QVariant();
+    }
+}
+
+QVariant FleetTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+    {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch (section)
+    {
+    case ID_COLUMN:
+        return "Drone ID";
+    case LATITUDE_COLUMN:
+        return "Latitude";
+    case LONGITUDE_COLUMN:
+        return "Longitude";
+    case ALTITUDE_COLUMN:
+        return "Altitude (m)";
+    case HEADING_COLUMN:
+        return "Heading (°)";
+    case SPEED_COLUMN:
+        return "Speed (m/s)";
+    case BATTERY_COLUMN:
+        return "Battery";
+    case GPS_FIX_COLUMN:
+        return "GPS Fix";
+    default:
+        return QVariant();
+    }
+}
+
+void FleetTableModel::sort(int column, Qt::SortOrder order)
+{
+    _sortColumn = (column >= 0 && column < COLUMN_COUNT) ? column : -1;
+    _sortOrder = order;
+    relayout();
+}
+
+void FleetTableModel::setFleet(const FleetState& fleet)
+{
+    bool sizeChanged = fleet.size() != _fleet.size();
+    _fleet = fleet;
+
+    if (sizeChanged || !rowsMatchFilter())
+    {
+        beginResetModel();
+        rebuildRows();
+        endResetModel();
+        return;
+    }
+
+    // Keep live-value sorts current, but not at the tick rate
+    if (_sortColumn > ID_COLUMN && _sinceSort.hasExpired(RESORT_INTERVAL_MS))
+    {
+        relayout();
+    }
+
+    // Off-screen rows are formatted fresh when scrolled into view
+    int lastRow = qMin(_lastVisibleRow, static_cast<int>(_rows.size()) - 1);
+    if (_firstVisibleRow >= 0 && _firstVisibleRow <= lastRow)
+    {
+        emit dataChanged(index(_firstVisibleRow, LATITUDE_COLUMN), index(lastRow, COLUMN_COUNT - 1),
+                         {Qt::DisplayRole});
+    }
+}
+
+void FleetTableModel::setGpsFixFilter(int gpsFixStatus)
+{
+    if (_gpsFixFilter != gpsFixStatus)
+    {
+        beginResetModel();
+        _gpsFixFilter = gpsFixStatus;
+        rebuildRows();
+        endResetModel();
+    }
+}
+
+void FleetTableModel::setVisibleRows(int firstRow, int lastRow)
+{
+    _firstVisibleRow = firstRow;
+    _lastVisibleRow = lastRow;
+}
+
+int FleetTableModel::slotForRow(int row) const
+{
+    return (row >= 0 && row < _rows.size()) ? _rows[row] : -1;
+}
+
+int FleetTableModel::rowForSlot(int slot) const
+{
+    return (slot >= 0 && slot < _rowOfSlot.size()) ? _rowOfSlot[slot] : -1;
+}
+
+void FleetTableModel::rebuildRows()
+{
+    _rows.clear();
+    _rows.reserve(_fleet.size());
+    for (int slot = 0; slot < _fleet.size(); ++slot)
+    {
+        if (acceptsSlot(slot))
+        {
+            _rows.append(slot);
+        }
+    }
+    sortRows();
+}
+
+void FleetTableModel::sortRows()
+{
+    if (_sortColumn == ID_COLUMN)
+    {
+        // Numeric collation puts DRONE-999 before DRONE-1000; keys are built once per sort
+        QVector<QPair<QCollatorSortKey, int>> keys;
+        keys.reserve(_rows.size());
+        for (int slot : _rows)
+        {
+            keys.append(qMakePair(_idCollator.sortKey(_fleet.name(slot)), slot));
+        }
+        std::sort(keys.begin(), keys.end(), [](const QPair<QCollatorSortKey, int>& a,
+                                               const QPair<QCollatorSortKey, int>& b) {
+            int order = a.first.compare(b.first);
+            return order != 0 ? order < 0 : a.second < b.second;
+        });
+        for (int row = 0; row < keys.size(); ++row)
+        {
+            _rows[row] = keys[row].second;
+        }
+    }
+    else if (_sortColumn > ID_COLUMN)
+    {
+        // Sort (key, slot) pairs so the hot loop reads contiguous memory
+        const double* values = nullptr;
+        switch (_sortColumn)
+        {
+        case LATITUDE_COLUMN: values = _fleet.latitudes(); break;
+        case LONGITUDE_COLUMN: values = _fleet.longitudes(); break;
+        case ALTITUDE_COLUMN: values = _fleet.altitudes(); break;
+        case HEADING_COLUMN: values = _fleet.headings(); break;
+        case SPEED_COLUMN: values = _fleet.speeds(); break;
+        default: break;
+        }
+
+        QVector<QPair<double, int>> keys;
+        keys.reserve(_rows.size());
+        for (int slot : _rows)
+        {
+            double key = 0.0;
+            if (values)
+            {
+                key = values[slot];
+            }
+            else if (_sortColumn == BATTERY_COLUMN)
+            {
+                key = _fleet.batteries()[slot];
+            }
+            else
+            {
+                key = static_cast<int>(_fleet.gpsFixStatuses()[slot]);
+            }
+            keys.append(qMakePair(key, slot));
+        }
+        std::sort(keys.begin(), keys.end());
+        for (int row = 0; row < keys.size(); ++row)
+        {
+            _rows[row] = keys[row].second;
+        }
+    }
+    else
+    {
+        std::sort(_rows.begin(), _rows.end()); // Fleet order
+    }
+
+    if (_sortColumn >= 0 && _sortOrder == Qt::DescendingOrder)
+    {
+        std::reverse(_rows.begin(), _rows.end());
+    }
+
+    _rowOfSlot.fill(-1, _fleet.size());
+    for (int row = 0; row < _rows.size(); ++row)
+    {
+        _rowOfSlot[_rows[row]] = row;
+    }
+    _sinceSort.restart();
+}
+
+void FleetTableModel::relayout()
+{
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+    // Remember which drone each persistent index (the selection) points at
+    const QModelIndexList oldIndexes = persistentIndexList();
+    QVector<int> persistentSlots;
+    persistentSlots.reserve(oldIndexes.size());
+    for (const QModelIndex& oldIndex : oldIndexes)
+    {
+        persistentSlots.append(slotForRow(oldIndex.row()));
+    }
+
+    sortRows();
+
+    QModelIndexList newIndexes;
+    newIndexes.reserve(oldIndexes.size());
+    for (int i = 0; i < oldIndexes.size(); ++i)
+    {
+        int row = rowForSlot(persistentSlots[i]);
+        newIndexes.append(row >= 0 ? index(row, oldIndexes[i].column()) : QModelIndex());
+    }
+    changePersistentIndexList(oldIndexes, newIndexes);
+
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+bool FleetTableModel::rowsMatchFilter() const
+{
+    if (_gpsFixFilter == NO_GPS_FILTER)
+    {
+        return _rows.size() == _fleet.size();
+    }
+
+    // Same count and every row still accepted means the same set of drones
+    int accepted = 0;
+    for (int slot = 0; slot < _fleet.size(); ++slot)
+    {
+        accepted += acceptsSlot(slot) ? 1 : 0;
+    }
+    if (accepted != _rows.size())
+    {
+        return false;
+    }
+    for (int slot : _rows)
+    {
+        if (!acceptsSlot(slot))
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,312 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+#include <QDebug>
+#include "telemetrymodel.h"
+#include "strategyfactory.h"
+#include "dronefactory.h"
+#include "drone.h"
+#include "logger.h"
+#include "tracerecorder.h"
+
+namespace
+{
+constexpr int MIXED_BLOCK_SIZE = 500; // Drones per strategy block with --strategy mixed
+
+/**
+ * @brief Append one CSV row per drone for the given snapshot
+ */
+void writeSnapshot(QTextStream& out, const TelemetrySnapshot& snapshot)
+{
+    const FleetState& fleet = snapshot.fleet;
+    const QString simulatedTime = QString::number(snapshot.simulationTime, 'f', 1);
+    
+    for (int i = 0; i < fleet.size(); ++i)
+    {
+        out << simulatedTime << ','
+            << fleet.name(i) << ','
+            << QString::number(fleet.latitudes()[i], 'f', 6) << ','
+            << QString::number(fleet.longitudes()[i], 'f', 6) << ','
+            << QString::number(fleet.altitudes()[i], 'f', 1) << ','
+            << QString::number(fleet.headings()[i], 'f', 1) << ','
+            << QString::number(fleet.speeds()[i], 'f', 1) << ','
+            << fleet.batteries()[i] << ','
+            << Drone::gpsFixStatusToString(fleet.gpsFixStatuses()[i]) << '\n';
+    }
+}
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {
+        QCoreApplication app(argc, argv);
+        
+        // Set application properties
+        app.setApplicationName("Drone Telemetry Headless");
+        app.setApplicationVersion("1.0.0");
+        app.setOrganizationName("BoltLab Dynamics");
+        
+        QCommandLineParser parser;
+        parser.setApplicationDescription("Runs the drone simulation without a UI, as fast as possible "
+                                         "or at a multiple of real time, and writes telemetry to a CSV file.");
+        parser.addHelpOption();
+        parser.addVersionOption();
+        
+        QCommandLineOption dronesOption("drones", "Number of drones to simulate.", "count", "1000");
+        QCommandLineOption durationOption("duration", "Simulated duration in seconds.", "seconds", "3600");
+        QCommandLineOption timeScaleOption("time-scale", "Multiple of real time (0 = as fast as possible).", "factor", "0");
+        QCommandLineOption timeStepOption("time-step", "Simulated seconds per tick.", "seconds", "0.5");
+        QCommandLineOption strategyOption("strategy", "Movement strategy: hover, randomwalk or mixed.", "name", "hover");
+        QCommandLineOption threadsOption("threads", "Tick threads (0 = one per core).", "count", "0");
+        QCommandLineOption seedOption("seed", "Simulation seed for reproducible runs (random if omitted).", "seed");
+        QCommandLineOption outputOption("output", "Telemetry CSV output file.", "file", "telemetry.csv");
+        QCommandLineOption intervalOption("output-interval", "Write telemetry every N ticks (0 = never).", "ticks", "20");
+        QCommandLineOption recordOption("record", "Record every tick to a binary telemetry recording.", "file");
+        QCommandLineOption profileOption("profile", "Write the tick-phase latency profile to a text file at the end.", "file");
+        QCommandLineOption traceOption("trace", "Write a Chrome trace of the last 10 s of the run to a JSON file.", "file");
+        QCommandLineOption spawnOption("spawn", "Spawn the fleet on a grid, in a random disk, or from --spawn-file "
+                                       "(grid, disk or file; default: every drone at the same point).", "pattern");
+        QCommandLineOption spawnFileOption("spawn-file", "CSV spawn list for --spawn file: id,latitude,longitude[,altitude] "
+                                           "per line (spawned in addition to DRONE-001).", "file");
+        QCommandLineOption spawnSpacingOption("spawn-spacing", "Grid spacing in metres for --spawn grid.", "metres", "20");
+        QCommandLineOption spawnRadiusOption("spawn-radius", "Disk radius in metres for --spawn disk.", "metres", "1000");
+        QCommandLineOption separationOption("separation", "Check every tick for drones closer than this horizontal "
+                                            "separation in metres and report the conflicts.", "metres");
+        QCommandLineOption verticalSeparationOption("vertical-separation", "Vertical separation minimum in metres "
+                                                    "for --separation.", "metres", "10");
+        parser.addOption(dronesOption);
+        parser.addOption(durationOption);
+        parser.addOption(timeScaleOption);
+        parser.addOption(timeStepOption);
+        parser.addOption(strategyOption);
+        parser.addOption(threadsOption);
+        parser.addOption(seedOption);
+        parser.addOption(outputOption);
+        parser.addOption(intervalOption);
+        parser.addOption(recordOption);
+        parser.addOption(profileOption);
+        parser.addOption(traceOption);
+        parser.addOption(spawnOption);
+        parser.addOption(spawnFileOption);
+        parser.addOption(spawnSpacingOption);
+        parser.addOption(spawnRadiusOption);
+        parser.addOption(separationOption);
+        parser.addOption(verticalSeparationOption);
+        parser.process(app);
+        
+        bool dronesOk = false;
+        bool durationOk = false;
+        bool timeScaleOk = false;
+        bool timeStepOk = false;
+        bool intervalOk = false;
+        bool threadsOk = false;
+        int droneCount = parser.value(dronesOption).toInt(&dronesOk);
+        double duration = parser.value(durationOption).toDouble(&durationOk);
+        double timeScale = parser.value(timeScaleOption).toDouble(&timeScaleOk);
+        double tickSeconds = parser.value(timeStepOption).toDouble(&timeStepOk);
+        int outputInterval = parser.value(intervalOption).toInt(&intervalOk);
+        int threadCount = parser.value(threadsOption).toInt(&threadsOk);
+        QString strategyName = parser.value(strategyOption).toLower();
+        bool spawnPatternOk = true;
+        bool spawnSpacingOk = false;
+        bool spawnRadiusOk = false;
+        SpawnDescriptor spawn;
+        if (parser.isSet(spawnOption))
+        {
+            spawn.pattern = DroneFactory::spawnPatternFromName(parser.value(spawnOption).toLower(), &spawnPatternOk);
+        }
+        spawn.spacing = parser.value(spawnSpacingOption).toDouble(&spawnSpacingOk);
+        spawn.radius = parser.value(spawnRadiusOption).toDouble(&spawnRadiusOk);
+        spawn.filePath = parser.value(spawnFileOption);
+        bool separationOk = true;
+        bool verticalSeparationOk = false;
+        double separation = 0.0;
+        if (parser.isSet(separationOption))
+        {
+            separation = parser.value(separationOption).toDouble(&separationOk);
+        }
+        double verticalSeparation = parser.value(verticalSeparationOption).toDouble(&verticalSeparationOk);
+        
+        if (!dronesOk || droneCount < 1 || !durationOk || duration <= 0.0 ||
+            !timeScaleOk || timeScale < 0.0 || !timeStepOk || tickSeconds <= 0.0 || !intervalOk || outputInterval < 0 ||
+            !threadsOk || threadCount < 0 ||
+            !spawnPatternOk || !spawnSpacingOk || spawn.spacing <= 0.0 || !spawnRadiusOk || spawn.radius < 0.0 ||
+            (spawn.pattern == SpawnDescriptor::FILE_PATTERN && parser.isSet(spawnOption) && spawn.filePath.isEmpty()) ||
+            !separationOk || (parser.isSet(separationOption) && separation <= 0.0) ||
+            !verticalSeparationOk || verticalSeparation <= 0.0 ||
+            (StrategyFactory::strategyTypeFromName(strategyName) == StrategyFactory::STRATEGY_TYPE_COUNT &&
+             strategyName != "mixed"))
+        {
+            qCritical() << "Invalid arguments, see --help";
+            return 1;
+        }
+        
+        Logger::setMinimumLevel(Logger::INFO);
+        Logger::getInstance().enableAsync();
+        
+        TelemetryModel model;
+        if (parser.isSet(seedOption))
+        {
+            model.setSeed(parser.value(seedOption).toULongLong());
+        }
+        model.setThreadCount(threadCount);
+        if (strategyName == "randomwalk")
+        {
+            model.setMovementStrategy(StrategyFactory::getSharedStrategy(StrategyFactory::RANDOM_WALK_STRATEGY));
+        }
+        
+        // The model already holds DRONE-001; add the rest of the fleet
+        if (parser.isSet(spawnOption))
+        {
+            spawn.count = droneCount - model.getFleet()->size();
+            spawn.seed = model.getSeed();
+            if (model.spawnDrones(spawn) == 0 && spawn.pattern == SpawnDescriptor::FILE_PATTERN)
+            {
+                qCritical() << "No drones could be spawned from" << spawn.filePath;
+                return 1;
+            }
+            droneCount = model.getFleet()->size(); // A spawn file decides the fleet size itself
+        }
+        else
+        {
+            model.resizeFleet(droneCount);
+        }
+        
+        if (strategyName == "mixed")
+        {
+            // Alternate blocks of hovering and random-walking drones
+            MovementStrategy* randomWalk = StrategyFactory::getSharedStrategy(StrategyFactory::RANDOM_WALK_STRATEGY);
+            for (int i = 0; i < droneCount; ++i)
+            {
+                if ((i / MIXED_BLOCK_SIZE) % 2 == 1)
+                {
+                    model.setDroneStrategy(i, randomWalk);
+                }
+            }
+        }
+        
+        if (parser.isSet(separationOption))
+        {
+            model.setSeparationMinima(separation, verticalSeparation);
+            model.setSeparationMonitoringEnabled(true);
+        }
+        
+        QFile outputFile(parser.value(outputOption));
+        QTextStream out;
+        if (outputInterval > 0)
+        {
+            if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text))
+            {
+                qCritical() << "Failed to open output file:" << outputFile.fileName() << outputFile.errorString();
+                return 1;
+            }
+            out.setDevice(&outputFile);
+            out << "time_s,id,latitude,longitude,altitude_m,heading_deg,speed_mps,battery_pct,gps_fix\n";
+        }
+        
+        const quint64 tickCount = static_cast<quint64>(duration / tickSeconds);
+        LOG_INFO(QString("Headless run: %1 drones, %2 ticks, time scale %3, %4 thread(s), seed %5")
+                 .arg(droneCount)
+                 .arg(tickCount)
+                 .arg(timeScale)
+                 .arg(threadCount > 0 ? threadCount : QThread::idealThreadCount())
+                 .arg(model.getSeed()));
+        
+        if (parser.isSet(recordOption) && !model.startRecording(parser.value(recordOption)))
+        {
+            qCritical() << "Failed to start recording:" << parser.value(recordOption);
+            return 1;
+        }
+        
+        // When paced, a tick that takes longer than its share of wall time is an overrun
+        if (timeScale > 0.0)
+        {
+            model.getProfiler()->setTickBudget(static_cast<qint64>(tickSeconds / timeScale * 1e9));
+        }
+        
+        // The CSV writer consumes snapshots like any other exporter
+        TelemetrySnapshotBuffer* snapshotBuffer = model.openSnapshotBuffer();
+        
+        QElapsedTimer wallClock;
+        wallClock.start();
+        
+        for (quint64 tick = 0; tick < tickCount; ++tick)
+        {
+            model.updateTelemetry(tickSeconds);
+            
+            if (outputInterval > 0 && (tick + 1) % static_cast<quint64>(outputInterval) == 0)
+            {
+                snapshotBuffer->acquireLatest();
+                writeSnapshot(out, snapshotBuffer->current());
+            }
+            
+            if (timeScale > 0.0)
+            {
+                // Pace the loop so simulated time runs at timeScale x wall-clock
+                qint64 targetMs = static_cast<qint64>((tick + 1) * tickSeconds * 1000.0 / timeScale);
+                qint64 aheadMs = targetMs - wallClock.elapsed();
+                if (aheadMs > 0)
+                {
+                    QThread::msleep(static_cast<unsigned long>(aheadMs));
+                }
+            }
+        }
+        
+        out.flush();
+        model.stopRecording();
+        
+        double wallSeconds = qMax<qint64>(wallClock.elapsed(), 1) / 1000.0;
+        LOG_INFO(QString("Headless run finished: %1 ticks in %2 s (%3 ticks/s, %4 drone-ticks/s, %5x real time)")
+                 .arg(tickCount)
+                 .arg(wallSeconds, 0, 'f', 3)
+                 .arg(tickCount / wallSeconds, 0, 'f', 1)
+                 .arg(tickCount * droneCount / wallSeconds, 0, 'f', 0)
+                 .arg(tickCount * tickSeconds / wallSeconds, 0, 'f', 1));
+        
+        const TickProfiler* profiler = model.getProfiler();
+        LatencyHistogram::Summary tickLatency = profiler->getHistogram(TickProfiler::TICK_PHASE).getSummary();
+        LOG_INFO(QString("Tick latency: p50 %1 ms, p99 %2 ms, p999 %3 ms, max %4 ms, %5 overrun(s)")
+                 .arg(tickLatency.p50 / 1e6, 0, 'f', 3)
+                 .arg(tickLatency.p99 / 1e6, 0, 'f', 3)
+                 .arg(tickLatency.p999 / 1e6, 0, 'f', 3)
+                 .arg(tickLatency.max / 1e6, 0, 'f', 3)
+                 .arg(profiler->getOverrunCount()));
+        if (model.isSeparationMonitoringEnabled())
+        {
+            LatencyHistogram::Summary detection =
+                profiler->getHistogram(TickProfiler::CONFLICT_DETECTION_PHASE).getSummary();
+            LOG_INFO(QString("Separation: %1 conflict(s) started, %2 active at the end; "
+                             "detection latency p50 %3 ms, p99 %4 ms, max %5 ms")
+                     .arg(model.getSeparationConflictCount())
+                     .arg(model.getActiveConflicts().size())
+                     .arg(detection.p50 / 1e6, 0, 'f', 3)
+                     .arg(detection.p99 / 1e6, 0, 'f', 3)
+                     .arg(detection.max / 1e6, 0, 'f', 3));
+        }
+        if (parser.isSet(profileOption))
+        {
+            profiler->writeReport(parser.value(profileOption));
+        }
+        if (parser.isSet(traceOption))
+        {
+            TraceRecorder::getInstance().writeTrace(parser.value(traceOption));
+        }
+        
+        Logger::getInstance().disableAsync();
+        return 0;
+    }
+    catch (const std::exception& e)
+    {
+        qCritical() << "Fatal error:" << e.what();
+        return 1;
+    }
+    catch (...)
+    {
+        qCritical() << "Unknown fatal error occurred";
+        return 1;
+    }
+}
@@ -1,7 +1,6 @@
 #include "hoverstrategy.h"
-#include "drone.h"
+#include "kinematics.h"
 #include "logger.h"
-#include <QRandomGenerator>
 
 HoverStrategy::HoverStrategy(QObject* parent)
     : MovementStrategy(parent)
@@ -9,25 +8,34 @@ HoverStrategy::HoverStrategy(QObject* parent)
     LOG_DEBUG("HoverStrategy created");
 }
 
-void HoverStrategy::updatePosition(Drone* drone)
+void HoverStrategy::updatePositions(const FleetSlice& slice, const TickContext& context)
 {
-    if (!drone) return;
+    const KinematicsKernels& kernels = Kinematics::kernels();
+    double samples[Kinematics::CHUNK_SIZE];
+    double noise = noiseScale(context.dt);
     
-    // Hovering behavior: minimal random movement
-    double latChange = (QRandomGenerator::global()->bounded(100) - 50) * 0.000001; // Very small changes
-    double lonChange = (QRandomGenerator::global()->bounded(100) - 50) * 0.000001;
-    double altChange = (QRandomGenerator::global()->bounded(20) - 10) * 0.1; // Small altitude changes
-    
-    drone->setLatitude(drone->getLatitude() + latChange);
-    drone->setLongitude(drone->getLongitude() + lonChange);
-    drone->setAltitude(drone->getAltitude() + altChange);
-    
-    // Minimal heading drift
-    double headingDrift = (QRandomGenerator::global()->bounded(20) - 10) * 0.1;
-    drone->setHeading(drone->getHeading() + headingDrift);
-    
-    // Keep speed very low for hovering
-    drone->setSpeed(QRandomGenerator::global()->bounded(5) * 0.1);
+    for (int begin = 0; begin < slice.count; begin += Kinematics::CHUNK_SIZE)
+    {
+        int count = qMin(Kinematics::CHUNK_SIZE, slice.count - begin);
+        quint32 firstIndex = static_cast<quint32>(slice.begin + begin);
+        
+        // Hovering behavior: minimal random movement
+        context.rng.fillUniform(samples, count, 100, context.tick, firstIndex, LATITUDE_STREAM);
+        kernels.addScaled(slice.latitudes + begin, samples, count, 50.0, 0.000001 * noise); // Very small changes
+        context.rng.fillUniform(samples, count, 100, context.tick, firstIndex, LONGITUDE_STREAM);
+        kernels.addScaled(slice.longitudes + begin, samples, count, 50.0, 0.000001 * noise);
+        context.rng.fillUniform(samples, count, 20, context.tick, firstIndex, ALTITUDE_STREAM);
+        kernels.addScaled(slice.altitudes + begin, samples, count, 10.0, 0.1 * noise); // Small altitude changes
+        
+        // Minimal heading drift
+        context.rng.fillUniform(samples, count, 20, context.tick, firstIndex, HEADING_STREAM);
+        kernels.addScaled(slice.headings + begin, samples, count, 10.0, 0.1 * noise);
+        kernels.wrapHeadings(slice.headings + begin, count);
+        
+        // Keep speed very low for hovering
+        context.rng.fillUniform(samples, count, 5, context.tick, firstIndex, SPEED_STREAM);
+        kernels.setScaled(slice.speeds + begin, samples, count, 0.0, 0.1);
+    }
 }
 
 QString HoverStrategy::getStrategyName() const
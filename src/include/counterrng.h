@@ -0,0 +1,61 @@
+#ifndef COUNTERRNG_H
+#define COUNTERRNG_H
+
+#include <QtGlobal>
+
+/**
+ * @brief Seedable counter-based random number generator (Philox4x32-10)
+ * Every sample is a pure function of (seed, drone index, tick, stream), so the
+ * generator holds no mutable state: any number of threads can draw from the
+ * same instance, results do not depend on how the fleet is chunked, and a run
+ * replays bit-exactly from its seed. Samples are produced in blocks of 32
+ * drones so the AVX2 path fills whole vector lanes per Philox evaluation.
+ */
+class CounterRng
+{
+public:
+    /**
+     * @brief Construct a generator keyed by the given seed
+     */
+    explicit CounterRng(quint64 seed = 0)
+        : _seed(seed)
+    {
+    }
+
+    /**
+     * @brief Get the generator seed
+     */
+    quint64 getSeed() const
+    {
+        return _seed;
+    }
+
+    /**
+     * @brief Fill samples with uniform integers in [0, bound) for consecutive drones
+     * @param samples Output buffer (stored as doubles for the kinematics kernels)
+     * @param count Number of drones to fill
+     * @param bound Exclusive upper bound of the samples
+     * @param tick Simulation tick
+     * @param firstIndex Fleet index of the first drone
+     * @param stream Independent stream id (one per drawn quantity)
+     */
+    void fillUniform(double* samples, int count, quint32 bound,
+                     quint64 tick, quint32 firstIndex, quint32 stream) const;
+
+    /**
+     * @brief Get a single uniform integer in [0, bound) for one drone
+     */
+    quint32 uniform(quint32 bound, quint64 tick, quint32 index, quint32 stream) const;
+
+    /**
+     * @brief Evaluate the raw Philox4x32-10 bijection
+     * @param counter Four 32-bit counter words, replaced by the four output words
+     * @param key Two 32-bit key words
+     */
+    static void philox(quint32 counter[4], const quint32 key[2]);
+
+private:
+    quint64 _seed; // Generator seed
+};
+
+#endif // COUNTERRNG_H
@@ -3,46 +3,89 @@
 
 #include <QObject>
 #include <QString>
-
-/**
- * @brief Enum for GPS fix status
- */
-enum class GPSFixStatus
-{
-    NO_FIX,   // No GPS fix
-    FIX_2D,   // 2D GPS fix
-    FIX_3D    // 3D GPS fix
-};
+#include <memory>
+#include "fleetstate.h"
+#include "telemetrytypes.h"
 
 /**
  * @brief Drone Class Represents a drone with telemetry data and failure simulations
+ * A Drone is a lightweight view onto one slot of a FleetState; the telemetry
+ * itself lives in the fleet's per-field arrays.
  */
 class Drone : public QObject
 {
     Q_OBJECT
 
 public:
+    static constexpr double BATTERY_DRAIN_PER_SECOND = 2.0;          // % per second in normal operation
+    static constexpr double FAILURE_BATTERY_DRAIN_PER_SECOND = 10.0; // % per second in failure mode
+
     /**
      * @brief Construct a new Drone object
-     * @param id: The drone's unique identifier
+     * @param name: The drone's unique name
+     * @param parent: The parent QObject
+     */
+    explicit Drone(const QString& name, QObject* parent = nullptr);
+
+    /**
+     * @brief Construct a Drone view onto an existing fleet slot
+     * @param fleet: The fleet that stores the drone's telemetry
+     * @param index: The drone's slot index in the fleet
      * @param parent: The parent QObject
      */
-    explicit Drone(const QString& id, QObject* parent = nullptr);
+    Drone(FleetState* fleet, int index, QObject* parent = nullptr);
+
+    /**
+     * @brief Destructor
+     */
+    ~Drone();
     
     /**
-     * @brief Get the drone's ID
+     * @brief Get the drone's interned ID
      */
-    QString getId() const
+    DroneId getId() const
     {
-        return _id;
+        return _fleet->id(_index);
     }
 
+    /**
+     * @brief Get the drone's display name (e.g. "DRONE-001")
+     */
+    const QString& getName() const
+    {
+        return _fleet->name(_index);
+    }
+
+    /**
+     * @brief Get the fleet storing this drone's telemetry
+     */
+    FleetState* getFleet() const
+    {
+        return _fleet;
+    }
+
+    /**
+     * @brief Get the drone's slot index in its fleet
+     */
+    int getIndex() const
+    {
+        return _index;
+    }
+
+    /**
+     * @brief Point the view at another fleet slot (e.g. after the drone moved slots, or when a pooled view is reused)
+     * Any pending batched update is discarded and nothing is logged or emitted.
+     * @param fleet: The fleet that stores the drone's telemetry
+     * @param index: The drone's slot index in the fleet
+     */
+    void attach(FleetState* fleet, int index);
+
     /**
      * @brief Get the latitude
      */
     double getLatitude() const
     {
-        return _latitude;
+        return _fleet->latitudes()[_index];
     }
 
     /**
@@ -50,7 +93,7 @@ public:
      */
     double getLongitude() const
     {
-        return _longitude;
+        return _fleet->longitudes()[_index];
     }
 
     /**
@@ -58,7 +101,7 @@ public:
      */
     double getAltitude() const
     {
-        return _altitude;
+        return _fleet->altitudes()[_index];
     }
 
     /**
@@ -66,7 +109,7 @@ public:
      */
     double getHeading() const
     {
-        return _heading;
+        return _fleet->headings()[_index];
     }
 
     /**
@@ -74,7 +117,7 @@ public:
      */
     double getSpeed() const
     {
-        return _speed;
+        return _fleet->speeds()[_index];
     }
 
     /**
@@ -82,7 +125,7 @@ public:
      */
     int getBattery() const
     {
-        return _battery;
+        return _fleet->batteries()[_index];
     }
 
     /**
@@ -90,9 +133,34 @@ public:
      */
     GPSFixStatus getGpsFixStatus() const
     {
-        return _gpsFixStatus;
+        return _fleet->gpsFixStatuses()[_index];
     }
     
+    /**
+     * @brief Begin a batched update; setter notifications are deferred until commitUpdate()
+     * Calls may nest; only the outermost commit emits.
+     */
+    void beginUpdate();
+
+    /**
+     * @brief Mark fields as changed by code that wrote the fleet arrays directly
+     * @param fields TelemetryField bits
+     */
+    void markChanged(quint32 fields);
+
+    /**
+     * @brief End a batched update, emitting one telemetryUpdated for all changed fields
+     */
+    void commitUpdate();
+
+    /**
+     * @brief Get the fields changed since beginUpdate() that commitUpdate() will report
+     */
+    quint32 getPendingFields() const
+    {
+        return _pendingFields;
+    }
+
     /**
      * @brief Set the latitude
      */
@@ -129,9 +197,25 @@ public:
     void setGpsFixStatus(GPSFixStatus status);
     
     /**
-     * @brief Simulate battery drain
+     * @brief Simulate battery drain over a time step
+     * @param dt: Simulated seconds elapsed
      */
-    void drainBattery();
+    void drainBattery(double dt);
+
+    /**
+     * @brief Accumulate drain for a time step and take the whole percents due
+     * @param failureMode: Whether the drone is in failure mode
+     * @param dt: Simulated seconds elapsed
+     * @param pendingDrain: Fractional drain carried between steps (updated)
+     * @return Whole battery percent to remove now
+     */
+    static int accumulateDrain(bool failureMode, double dt, double& pendingDrain)
+    {
+        pendingDrain += (failureMode ? FAILURE_BATTERY_DRAIN_PER_SECOND : BATTERY_DRAIN_PER_SECOND) * dt;
+        int whole = static_cast<int>(pendingDrain);
+        pendingDrain -= whole;
+        return whole;
+    }
 
     /**
      * @brief Simulate failure mode (GPS loss, rapid battery drain)
@@ -147,12 +231,18 @@ public:
      * @brief Get the GPS fix status as a string
      */
     QString getGpsFixStatusString() const;
+
+    /**
+     * @brief Convert a GPS fix status to its display string
+     */
+    static QString gpsFixStatusToString(GPSFixStatus status);
     
 signals:
     /**
-     * @brief Emitted when telemetry data is updated
+     * @brief Emitted when telemetry data is updated (once per committed update)
+     * @param changedFields TelemetryField bits of the fields that changed
      */
-    void telemetryUpdated();
+    void telemetryUpdated(quint32 changedFields);
 
     /**
      * @brief Emitted when battery is low
@@ -175,15 +265,11 @@ signals:
     void failureReset();
 
 private:
-    QString _id;              // Drone ID
-    double _latitude;         // Latitude
-    double _longitude;        // Longitude
-    double _altitude;         // Altitude
-    double _heading;          // Heading (degrees)
-    double _speed;            // Speed (m/s)
-    int _battery;             // Battery percentage
-    GPSFixStatus _gpsFixStatus; // GPS fix status
-    bool _failureMode;        // Failure mode flag
+    std::unique_ptr<FleetState> _ownedFleet; // Private single-slot fleet for standalone drones
+    FleetState* _fleet;       // Fleet storing the telemetry
+    int _index;               // Slot index in the fleet
+    int _updateDepth;         // Nesting depth of beginUpdate()
+    quint32 _pendingFields;   // TelemetryField bits changed since the last notification
 };
 
 #endif // DRONE_H 
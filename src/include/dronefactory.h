@@ -3,8 +3,39 @@
 
 #include <QObject>
 #include <QString>
+#include <QVector>
+#include "fleetstate.h"
 
 class Drone;
+class DronePool;
+
+/**
+ * @brief Where DroneFactory::spawnDrones() places a batch of drones
+ */
+struct SpawnDescriptor
+{
+    /**
+     * @brief Placement patterns
+     */
+    enum Pattern
+    {
+        GRID_PATTERN,        // Square grid centred on the point, spacing metres apart
+        RANDOM_DISK_PATTERN, // Uniformly at random within radius metres of the point
+        FILE_PATTERN         // One drone per line of a CSV file: id,latitude,longitude[,altitude]
+    };
+
+    Pattern pattern = GRID_PATTERN;
+    int count = 0;                                     // Drones to spawn (grid and disk; a file spawns every line)
+    double latitude = FleetState::DEFAULT_LATITUDE;    // Centre of the grid or disk
+    double longitude = FleetState::DEFAULT_LONGITUDE;
+    double altitude = FleetState::DEFAULT_ALTITUDE;    // Altitude (m) of grid and disk drones, and file lines without one
+    double spacing = 20.0;                             // Grid spacing (m)
+    double radius = 1000.0;                            // Disk radius (m)
+    quint64 seed = 0;                                  // Disk placement seed (drawn on the spawn streams of MovementStrategy::RandomStream)
+    QString idPrefix = "DRONE-";                       // Generated IDs: prefix + zero-padded number (DRONE-001, ...)
+    int firstNumber = 1;                               // Number of the first generated ID (see assignGeneratedIds)
+    QString filePath;                                  // Spawn list for FILE_PATTERN
+};
 
 class DroneFactory : public QObject
 {
@@ -26,6 +57,77 @@ public:
                              double longitude, 
                              double altitude,
                              QObject* parent = nullptr);
+
+    /**
+     * @brief Factory method to add a drone to a fleet and return a view onto its slot
+     */
+    static Drone* createDrone(FleetState* fleet,
+                             const QString& id,
+                             QObject* parent = nullptr);
+
+    /**
+     * @brief Factory method to add a drone to a fleet and take a recycled view onto its slot from a pool
+     * Logs at debug level only, so swarms can spawn thousands of drones per second.
+     */
+    static Drone* acquireDrone(DronePool* pool,
+                               FleetState* fleet,
+                               const QString& id);
+
+    /**
+     * @brief Spawn a whole batch of drones straight into fleet storage
+     * Grows every field array once and writes positions directly, without Drone
+     * views, per-drone signals or per-drone log lines; one summary line is logged.
+     * If the name table fills up, the drones that got no ID are not spawned.
+     * @param nextNumber Receives the number after the last generated ID, to start the next spawn from
+     * @param freeIds IDs of despawned drones to reuse first (see assignGeneratedIds)
+     * @return Number of drones spawned (0 if the spawn file could not be read)
+     */
+    static int spawnDrones(FleetState* fleet, const SpawnDescriptor& descriptor, int* nextNumber = nullptr,
+                           QVector<DroneId>* freeIds = nullptr);
+
+    /**
+     * @brief Give count new drones from slot first generated IDs (prefix + number), interning the names in one batch
+     * IDs from freeIds whose name has the prefix are reused first (and removed
+     * from it); then numbers are used in order from *nextNumber. Either way a
+     * name a live drone already has (e.g. from a spawn file or a loaded
+     * recording) is skipped, so no two drones in the fleet share a DroneId.
+     * Stops early, leaving the remaining slots without an ID, if the name table is full.
+     * @param nextNumber Number to start from; receives the number after the last one used
+     * @return Number of drones given an ID (from slot first on)
+     */
+    static int assignGeneratedIds(FleetState* fleet, int first, int count, const QString& prefix,
+                                  int* nextNumber, QVector<DroneId>* freeIds = nullptr);
+
+    /**
+     * @brief Parse a spawn pattern name ("grid", "disk" or "file")
+     * @param ok Set to false if the name is unknown
+     */
+    static SpawnDescriptor::Pattern spawnPatternFromName(const QString& name, bool* ok = nullptr);
+
+private:
+    /**
+     * @brief Assign generated IDs to freshly added drones and drop those the name table had no room for
+     * @return Number of drones kept
+     */
+    static int assignSpawnIds(FleetState* fleet, int first, int count, const QString& prefix,
+                              int* nextNumber, QVector<DroneId>* freeIds);
+
+    /**
+     * @brief Place count new drones from slot first on a grid (positions only)
+     */
+    static void placeGrid(FleetState* fleet, int first, int count, const SpawnDescriptor& descriptor);
+
+    /**
+     * @brief Place count new drones from slot first at random within a disk (positions only)
+     */
+    static void placeRandomDisk(FleetState* fleet, int first, int count, const SpawnDescriptor& descriptor);
+
+    /**
+     * @brief Append the drones listed in the descriptor's file
+     * Lines whose ID repeats an earlier line or a live drone are skipped with a warning.
+     * @return Number of drones spawned, or -1 if the file could not be opened
+     */
+    static int spawnFromFile(FleetState* fleet, const SpawnDescriptor& descriptor);
 };
 
 #endif // DRONEFACTORY_H 
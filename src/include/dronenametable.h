@@ -0,0 +1,97 @@
+#ifndef DRONENAMETABLE_H
+#define DRONENAMETABLE_H
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <atomic>
+#include "telemetrytypes.h"
+
+/**
+ * @brief Singleton string-interning table between drone names and DroneIds
+ * Every distinct name gets a dense DroneId the first time it is interned and
+ * keeps it for the life of the process, so fleet storage, snapshots and
+ * recordings carry four-byte integers and only the UI turns them back into
+ * names. Interning takes a lock; name() is lock-free: names live in segments
+ * that never move, published by the release store of the name count.
+ *
+ * Entries are never freed, so an ID always names the same drone for
+ * snapshots and recordings still holding it. Fleets that churn reuse the
+ * names of despawned drones instead (see DroneFactory::assignGeneratedIds).
+ */
+class DroneNameTable
+{
+public:
+    static constexpr int SEGMENT_BITS = 12;                       // log2 of names per segment
+    static constexpr int SEGMENT_SIZE = 1 << SEGMENT_BITS;        // Names per segment
+    static constexpr int MAX_SEGMENTS = 4096;                     // Room for 16M distinct names
+    static constexpr int MAX_NAMES = MAX_SEGMENTS * SEGMENT_SIZE; // Default and largest capacity
+    static constexpr DroneId INVALID_DRONE_ID = 0xFFFFFFFFu;      // Returned when the table is full
+
+    /**
+     * @brief Get the singleton instance
+     */
+    static DroneNameTable& getInstance();
+
+    /**
+     * @brief Get the ID of a name, assigning the next free ID if it is new (any thread)
+     * @return The ID, or INVALID_DRONE_ID if the name is new and the table is full
+     */
+    DroneId intern(const QString& name);
+
+    /**
+     * @brief Intern a batch of names under a single lock
+     * @param names count names to intern
+     * @param ids Receives the ID of each name (INVALID_DRONE_ID for new names once the table is full)
+     * @return Number of names that could not be interned
+     */
+    int internAll(const QString* names, int count, DroneId* ids);
+
+    /**
+     * @brief Limit the number of distinct names (clamped to [size(), MAX_NAMES])
+     * For memory-capped deployments, and for tests that need a full table.
+     */
+    void setCapacity(int capacity);
+
+    /**
+     * @brief Get the name of an ID (any thread, lock-free)
+     * @return The name, or an empty string for an unknown ID
+     */
+    const QString& name(DroneId id) const
+    {
+        if (id >= _count.load(std::memory_order_acquire))
+        {
+            return _emptyName;
+        }
+        return _segments[id >> SEGMENT_BITS][id & (SEGMENT_SIZE - 1)];
+    }
+
+    /**
+     * @brief Get the number of interned names
+     */
+    int size() const
+    {
+        return static_cast<int>(_count.load(std::memory_order_acquire));
+    }
+
+private:
+    DroneNameTable();
+
+    DroneNameTable(const DroneNameTable&) = delete;
+    DroneNameTable& operator=(const DroneNameTable&) = delete;
+
+    /**
+     * @brief Intern one name (caller holds _mutex)
+     * @return The ID, or INVALID_DRONE_ID if the name is new and the table is full
+     */
+    DroneId internLocked(const QString& name);
+
+    QMutex _mutex;                        // Guards interning
+    QHash<QString, DroneId> _ids;         // Name to ID (guarded by _mutex)
+    QString* _segments[MAX_SEGMENTS];     // Name storage by ID; a segment never moves once allocated
+    std::atomic<quint32> _count;          // Names published to name()
+    quint32 _capacity;                    // Most names the table may hold (guarded by _mutex)
+    const QString _emptyName;             // Returned for unknown IDs
+};
+
+#endif // DRONENAMETABLE_H
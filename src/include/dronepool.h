@@ -0,0 +1,63 @@
+#ifndef DRONEPOOL_H
+#define DRONEPOOL_H
+
+#include <QObject>
+#include <QVector>
+
+class Drone;
+class FleetState;
+
+/**
+ * @brief Recycles Drone views so selecting, spawning and despawning drones does not allocate
+ * A released view is disconnected from every receiver and kept on a free list;
+ * the next acquire() re-attaches it to another slot instead of constructing a
+ * new QObject. Views stay owned by the pool (they are its children), so a
+ * pointer to a released view remains valid until the pool is destroyed. Not
+ * thread-safe: use it from one thread or under the owner's lock.
+ */
+class DronePool : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Construct an empty pool
+     * @param parent The parent QObject
+     */
+    explicit DronePool(QObject* parent = nullptr);
+
+    /**
+     * @brief Get a view onto a fleet slot, reusing a released view if there is one
+     * @param fleet The fleet that stores the drone's telemetry
+     * @param index The drone's slot index in the fleet
+     */
+    Drone* acquire(FleetState* fleet, int index);
+
+    /**
+     * @brief Return a view from acquire() to the pool
+     * The view is disconnected from every receiver; do not use it afterwards.
+     */
+    void release(Drone* drone);
+
+    /**
+     * @brief Get the number of views currently handed out
+     */
+    int getActiveCount() const
+    {
+        return _createdCount - _free.size();
+    }
+
+    /**
+     * @brief Get the number of views ever constructed by the pool
+     */
+    int getCreatedCount() const
+    {
+        return _createdCount;
+    }
+
+private:
+    QVector<Drone*> _free; // Released views ready for reuse
+    int _createdCount;     // Views constructed so far
+};
+
+#endif // DRONEPOOL_H
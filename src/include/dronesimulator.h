@@ -4,11 +4,18 @@
 #include <QObject>
 #include <QThread>
 #include <QMutex>
+#include <QElapsedTimer>
+#include <atomic>
+
+#include "fixedstepscheduler.h"
 
 class TelemetryModel;
+class QTimer;
 
 /**
  * @brief DroneSimulator class manages the simulation worker thread for drone telemetry
+ * The simulator itself lives on the UI thread; its tick timer is created on
+ * _simulationThread, so every TelemetryModel tick runs off the UI thread.
  */
 class DroneSimulator : public QObject
 {
@@ -38,7 +45,7 @@ public:
     bool isSimulationRunning() const;
     
     /**
-     * @brief Set the telemetry model to simulate
+     * @brief Set the telemetry model to simulate (only while the simulation is stopped)
      */
     void setTelemetryModel(TelemetryModel* model);
 
@@ -46,6 +53,28 @@ public:
      * @brief Get the current telemetry model
      */
     TelemetryModel* getTelemetryModel() const { return _telemetryModel; }
+
+    /**
+     * @brief Set how many simulated seconds pass per wall-clock second
+     * Clamped to [FixedStepScheduler::MIN_TIME_SCALE, FixedStepScheduler::MAX_TIME_SCALE];
+     * takes effect on the next tick, so it may be changed while running.
+     */
+    void setTimeScale(double timeScale);
+
+    /**
+     * @brief Get the time-scale factor
+     */
+    double getTimeScale() const { return _timeScale.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Set the simulated seconds per tick (only while the simulation is stopped)
+     */
+    void setTimeStep(double stepSeconds);
+
+    /**
+     * @brief Get the simulated seconds per tick
+     */
+    double getTimeStep() const { return _scheduler.getStepSeconds(); }
     
 signals:
     /**
@@ -63,9 +92,14 @@ signals:
      */
     void error(const QString& errorMessage);
 
+    /**
+     * @brief Emitted when the time-scale factor changes
+     */
+    void timeScaleChanged(double timeScale);
+
 private slots:
     /**
-     * @brief Run the simulation (worker thread entry point)
+     * @brief Run the simulation (worker thread entry point, sets up the tick timer)
      */
     void runSimulation();
 
@@ -77,13 +111,27 @@ private slots:
 private:
     TelemetryModel* _telemetryModel; // Telemetry model pointer
     QThread* _simulationThread;      // Worker thread
+    QTimer* _tickTimer;              // Wake-up timer, owned by the worker thread
+    FixedStepScheduler _scheduler;   // Wall time to fixed steps, used on the worker thread
+    QElapsedTimer _wallClock;        // Monotonic clock feeding the scheduler
+    std::atomic<double> _timeScale;  // Requested time scale, picked up by the worker
     mutable QMutex _mutex;           // Mutex for thread safety
     bool _running;                   // Simulation running flag
     
     /**
-     * @brief Move this object to the worker thread
+     * @brief Run every fixed step that is due (worker thread, on each timer wake-up)
+     */
+    void onTick();
+
+    /**
+     * @brief Give the model's profiler the wall time one step may take at the current scale
+     */
+    void updateTickBudget();
+
+    /**
+     * @brief Stop and join the worker thread
      */
-    void moveToThread();
+    void stopThread();
 };
 
 #endif // DRONESIMULATOR_H 
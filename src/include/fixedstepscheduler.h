@@ -0,0 +1,91 @@
+#ifndef FIXEDSTEPSCHEDULER_H
+#define FIXEDSTEPSCHEDULER_H
+
+#include <QtGlobal>
+
+/**
+ * @brief Fixed-timestep scheduler that converts elapsed wall time into simulation steps
+ * Wall time is scaled by the time-scale factor and accumulated; each call to
+ * advance() reports how many whole steps of getStepSeconds() are due. Lag
+ * beyond the catch-up bound is dropped (and counted) so a slow tick cannot
+ * snowball into an ever-growing backlog.
+ */
+class FixedStepScheduler
+{
+public:
+    static constexpr double MIN_TIME_SCALE = 0.1;    // Slowest supported time scale
+    static constexpr double MAX_TIME_SCALE = 1000.0; // Fastest supported time scale
+
+    /**
+     * @brief Construct a scheduler
+     * @param stepSeconds Simulated seconds per step (dt)
+     * @param maxCatchUpSteps Most steps a single advance() may return
+     */
+    explicit FixedStepScheduler(double stepSeconds = 0.5, int maxCatchUpSteps = 8);
+
+    /**
+     * @brief Set the simulated seconds per step
+     */
+    void setStepSeconds(double stepSeconds);
+
+    /**
+     * @brief Get the simulated seconds per step
+     */
+    double getStepSeconds() const
+    {
+        return _stepSeconds;
+    }
+
+    /**
+     * @brief Set the time-scale factor (clamped to [MIN_TIME_SCALE, MAX_TIME_SCALE])
+     */
+    void setTimeScale(double timeScale);
+
+    /**
+     * @brief Get the time-scale factor
+     */
+    double getTimeScale() const
+    {
+        return _timeScale;
+    }
+
+    /**
+     * @brief Set the most steps a single advance() may return
+     */
+    void setMaxCatchUpSteps(int maxCatchUpSteps);
+
+    /**
+     * @brief Reset the accumulated lag and start measuring from the given wall time
+     */
+    void start(qint64 wallNs);
+
+    /**
+     * @brief Account for wall time elapsed since the last call
+     * @param wallNs Current monotonic wall time in nanoseconds
+     * @return Number of fixed steps to run now
+     */
+    int advance(qint64 wallNs);
+
+    /**
+     * @brief Get the total number of steps dropped because of the catch-up bound
+     */
+    quint64 getDroppedSteps() const
+    {
+        return _droppedSteps;
+    }
+
+    /**
+     * @brief Get a timer interval (ms) that polls often enough for the current step and scale
+     */
+    int getWakeIntervalMs() const;
+
+private:
+    double _stepSeconds;         // Simulated seconds per step
+    double _timeScale;           // Simulated seconds per wall second
+    int _maxCatchUpSteps;        // Catch-up bound per advance()
+    qint64 _lastWallNs;          // Wall time of the previous advance()
+    double _accumulatedSeconds;  // Simulated time owed but not yet stepped
+    quint64 _droppedSteps;       // Steps discarded by the catch-up bound
+};
+
+#endif // FIXEDSTEPSCHEDULER_H
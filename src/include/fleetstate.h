@@ -0,0 +1,239 @@
+#ifndef FLEETSTATE_H
+#define FLEETSTATE_H
+
+#include <QString>
+#include <QVector>
+#include "dronenametable.h"
+#include "telemetrytypes.h"
+
+/**
+ * @brief Non-owning view over a contiguous range of fleet slots
+ * Pointers address the first slot of the range in each per-field array.
+ */
+struct FleetSlice
+{
+    int begin = 0;                          // Index of the first slot in the fleet
+    int count = 0;                          // Number of slots in the slice
+    double* latitudes = nullptr;
+    double* longitudes = nullptr;
+    double* altitudes = nullptr;
+    double* headings = nullptr;
+    double* speeds = nullptr;
+    int* batteries = nullptr;
+    double* batteryDrains = nullptr;
+    GPSFixStatus* gpsFixStatuses = nullptr;
+    quint8* failureModes = nullptr;
+    quint8* strategyIds = nullptr;
+
+    /**
+     * @brief Get a view over slots [offset, offset + length) of this slice
+     */
+    FleetSlice subSlice(int offset, int length) const
+    {
+        FleetSlice result;
+        result.begin = begin + offset;
+        result.count = length;
+        result.latitudes = latitudes + offset;
+        result.longitudes = longitudes + offset;
+        result.altitudes = altitudes + offset;
+        result.headings = headings + offset;
+        result.speeds = speeds + offset;
+        result.batteries = batteries + offset;
+        result.batteryDrains = batteryDrains + offset;
+        result.gpsFixStatuses = gpsFixStatuses + offset;
+        result.failureModes = failureModes + offset;
+        result.strategyIds = strategyIds + offset;
+        return result;
+    }
+};
+
+/**
+ * @brief Structure-of-arrays storage for the telemetry of a whole drone fleet
+ * Each telemetry field lives in its own contiguous array indexed by drone slot,
+ * so a simulation tick can walk memory linearly instead of visiting one Drone
+ * object at a time. Drone objects act as lightweight views onto a single slot.
+ */
+class FleetState
+{
+public:
+    // Default spawn position: New Delhi
+    static constexpr double DEFAULT_LATITUDE = 28.6139;
+    static constexpr double DEFAULT_LONGITUDE = 77.2090;
+    static constexpr double DEFAULT_ALTITUDE = 100.0;
+
+    /**
+     * @brief Construct an empty fleet
+     */
+    FleetState() = default;
+
+    /**
+     * @brief Get the number of drones in the fleet
+     */
+    int size() const
+    {
+        return static_cast<int>(_ids.size());
+    }
+
+    /**
+     * @brief Check if the fleet has no drones
+     */
+    bool isEmpty() const
+    {
+        return _ids.isEmpty();
+    }
+
+    /**
+     * @brief Reserve storage for the given number of drones
+     */
+    void reserve(int count);
+
+    /**
+     * @brief Remove all drones from the fleet
+     */
+    void clear();
+
+    /**
+     * @brief Append a drone with default telemetry (New Delhi, 100 m, full battery, 3D fix)
+     * @param name The drone's unique name, interned in DroneNameTable
+     * @return Slot index of the new drone
+     */
+    int addDrone(const QString& name);
+
+    /**
+     * @brief Append a drone at a specific initial position
+     * @return Slot index of the new drone
+     */
+    int addDrone(const QString& name, double latitude, double longitude, double altitude);
+
+    /**
+     * @brief Append a drone with an already interned ID at a specific initial position
+     * @return Slot index of the new drone
+     */
+    int addDrone(DroneId id, double latitude, double longitude, double altitude);
+
+    /**
+     * @brief Append count drones with default telemetry and no ID (INVALID_DRONE_ID) in one step
+     * Each array grows once; fill in the IDs with setId() and the positions
+     * through the field arrays. Used for bulk spawning.
+     * @return Slot index of the first new drone
+     */
+    int addDrones(int count);
+
+    /**
+     * @brief Set the ID of the drone in the given slot
+     */
+    void setId(int index, DroneId id)
+    {
+        _ids[index] = id;
+        indexSlot(index);
+    }
+
+    /**
+     * @brief Get the slot of the drone with the given ID, or -1 if no drone in the fleet has it
+     */
+    int slotOf(DroneId id) const
+    {
+        if (id >= static_cast<DroneId>(_slotOfId.size()))
+        {
+            return -1;
+        }
+        int slot = _slotOfId[static_cast<int>(id)];
+        return slot >= 0 && slot < size() && _ids[slot] == id ? slot : -1;
+    }
+
+    /**
+     * @brief Remove a drone by moving the last drone into its slot
+     * Keeps the arrays dense and their capacity, so despawning and respawning
+     * drones reuses the same storage without touching the allocator.
+     * @param index Slot of the drone to remove
+     * @return The slot the last drone was moved from, or -1 if index was the last slot
+     */
+    int removeDrone(int index);
+
+    /**
+     * @brief Get a counter that changes whenever drones move to other slots (removal, clear)
+     * Consumers that key data by slot compare it to notice slots changing owner.
+     */
+    quint32 getLayoutVersion() const
+    {
+        return _layoutVersion;
+    }
+
+    /**
+     * @brief Get a mutable view over slots [begin, begin + count)
+     */
+    FleetSlice slice(int begin, int count);
+
+    /**
+     * @brief Get a mutable view over the whole fleet
+     */
+    FleetSlice slice()
+    {
+        return slice(0, size());
+    }
+
+    /**
+     * @brief Get the ID of the drone in the given slot
+     */
+    DroneId id(int index) const
+    {
+        return _ids[index];
+    }
+
+    /**
+     * @brief Get the display name of the drone in the given slot
+     */
+    const QString& name(int index) const
+    {
+        return DroneNameTable::getInstance().name(_ids[index]);
+    }
+
+    /**
+     * @brief Get the contiguous array of drone IDs, one per slot (change them with setId())
+     */
+    const DroneId* ids() const { return _ids.constData(); }
+
+    // Contiguous per-field arrays, one entry per drone slot
+    double* latitudes() { return _latitudes.data(); }
+    const double* latitudes() const { return _latitudes.constData(); }
+    double* longitudes() { return _longitudes.data(); }
+    const double* longitudes() const { return _longitudes.constData(); }
+    double* altitudes() { return _altitudes.data(); }
+    const double* altitudes() const { return _altitudes.constData(); }
+    double* headings() { return _headings.data(); }
+    const double* headings() const { return _headings.constData(); }
+    double* speeds() { return _speeds.data(); }
+    const double* speeds() const { return _speeds.constData(); }
+    int* batteries() { return _batteries.data(); }
+    const int* batteries() const { return _batteries.constData(); }
+    double* batteryDrains() { return _batteryDrains.data(); }
+    const double* batteryDrains() const { return _batteryDrains.constData(); }
+    GPSFixStatus* gpsFixStatuses() { return _gpsFixStatuses.data(); }
+    const GPSFixStatus* gpsFixStatuses() const { return _gpsFixStatuses.constData(); }
+    quint8* failureModes() { return _failureModes.data(); }
+    const quint8* failureModes() const { return _failureModes.constData(); }
+    quint8* strategyIds() { return _strategyIds.data(); }
+    const quint8* strategyIds() const { return _strategyIds.constData(); }
+
+private:
+    /**
+     * @brief Point the slot lookup of the ID in the given slot at that slot
+     */
+    void indexSlot(int index);
+
+    QVector<DroneId> _ids;                  // Interned drone IDs
+    QVector<int> _slotOfId;                 // Slot per DroneId; an entry counts only while _ids agrees
+    QVector<double> _latitudes;             // Latitude per drone
+    QVector<double> _longitudes;            // Longitude per drone
+    QVector<double> _altitudes;             // Altitude per drone (m)
+    QVector<double> _headings;              // Heading per drone (degrees)
+    QVector<double> _speeds;                // Speed per drone (m/s)
+    QVector<int> _batteries;                // Battery percentage per drone
+    QVector<double> _batteryDrains;         // Fractional battery drain not yet applied (%)
+    QVector<GPSFixStatus> _gpsFixStatuses;  // GPS fix status per drone
+    QVector<quint8> _failureModes;          // Failure mode flag per drone
+    QVector<quint8> _strategyIds;           // Movement strategy slot per drone (0 = model default)
+    quint32 _layoutVersion = 0;             // Bumped when drones change slots
+};
+
+#endif // FLEETSTATE_H
@@ -0,0 +1,134 @@
+#ifndef FLEETTABLEMODEL_H
+#define FLEETTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QCollator>
+#include <QElapsedTimer>
+#include <QVector>
+#include "fleetstate.h"
+
+/**
+ * @brief Table model presenting a fleet snapshot, one row per drone
+ * Rows map to fleet slots through a filtered, sorted index, so the model
+ * never copies telemetry: each new snapshot just replaces the (implicitly
+ * shared) fleet and announces changes for the rows currently on screen.
+ * Re-sorting on live values is throttled so large fleets stay responsive.
+ */
+class FleetTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Table columns
+     */
+    enum Column
+    {
+        ID_COLUMN,
+        LATITUDE_COLUMN,
+        LONGITUDE_COLUMN,
+        ALTITUDE_COLUMN,
+        HEADING_COLUMN,
+        SPEED_COLUMN,
+        BATTERY_COLUMN,
+        GPS_FIX_COLUMN,
+        COLUMN_COUNT
+    };
+
+    static constexpr int NO_GPS_FILTER = -1;        // Filter value that shows every drone
+    static constexpr int RESORT_INTERVAL_MS = 250;  // Minimum time between re-sorts on live data
+
+    /**
+     * @brief Construct an empty fleet table model
+     * @param parent The parent QObject
+     */
+    explicit FleetTableModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Sort rows by a column; numeric columns are re-sorted as values change
+     */
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    /**
+     * @brief Show a new fleet snapshot
+     * Emits dataChanged only for the visible rows, or resets the model when
+     * the set of rows changes (fleet size, or a drone crossing the GPS filter).
+     */
+    void setFleet(const FleetState& fleet);
+
+    /**
+     * @brief Show only drones with the given GPSFixStatus value (NO_GPS_FILTER = all)
+     */
+    void setGpsFixFilter(int gpsFixStatus);
+
+    /**
+     * @brief Get the current GPS filter (NO_GPS_FILTER = all)
+     */
+    int getGpsFixFilter() const
+    {
+        return _gpsFixFilter;
+    }
+
+    /**
+     * @brief Set the range of rows on screen, the only ones refreshed by setFleet()
+     */
+    void setVisibleRows(int firstRow, int lastRow);
+
+    /**
+     * @brief Get the fleet slot shown in a row, or -1
+     */
+    int slotForRow(int row) const;
+
+    /**
+     * @brief Get the row showing a fleet slot, or -1 if it is filtered out
+     */
+    int rowForSlot(int slot) const;
+
+private:
+    FleetState _fleet;             // Fleet snapshot being shown (shares the snapshot's arrays)
+    QVector<int> _rows;            // Fleet slot per row, after filtering and sorting
+    QVector<int> _rowOfSlot;       // Row per fleet slot (-1 = filtered out)
+    int _sortColumn;               // Sort column (-1 = fleet order)
+    Qt::SortOrder _sortOrder;      // Sort direction
+    int _gpsFixFilter;             // GPSFixStatus shown, or NO_GPS_FILTER
+    int _firstVisibleRow;          // First row on screen
+    int _lastVisibleRow;           // Last row on screen
+    QElapsedTimer _sinceSort;      // Time since the rows were last sorted
+    QCollator _idCollator;         // Numeric-mode collation for the ID column
+
+    /**
+     * @brief Rebuild the filtered, sorted row index (no signals)
+     */
+    void rebuildRows();
+
+    /**
+     * @brief Sort _rows by the sort column and refresh _rowOfSlot (no signals)
+     */
+    void sortRows();
+
+    /**
+     * @brief Re-sort with layout signals, keeping persistent indexes (selection) on their drones
+     */
+    void relayout();
+
+    /**
+     * @brief Check whether the rows still hold exactly the drones that pass the GPS filter
+     */
+    bool rowsMatchFilter() const;
+
+    /**
+     * @brief Check whether a slot passes the GPS filter
+     */
+    bool acceptsSlot(int slot) const
+    {
+        return _gpsFixFilter == NO_GPS_FILTER ||
+               static_cast<int>(_fleet.gpsFixStatuses()[slot]) == _gpsFixFilter;
+    }
+};
+
+#endif // FLEETTABLEMODEL_H
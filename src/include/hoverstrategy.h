@@ -19,10 +19,11 @@ public:
     explicit HoverStrategy(QObject* parent = nullptr);
     
     /**
-     * @brief Update the drone's position to simulate hovering
-     * @param drone Pointer to the drone to update
+     * @brief Update the positions of all drones in the slice to simulate hovering
+     * @param slice View over the fleet slots to update
+     * @param context Tick number and random generator for this tick
      */
-    void updatePosition(Drone* drone) override;
+    void updatePositions(const FleetSlice& slice, const TickContext& context) override;
 
     /**
      * @brief Get the name of this strategy
@@ -0,0 +1,61 @@
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+
+/**
+ * @brief Table of data-parallel kernels used by the movement strategies
+ * Every kernel works on plain double arrays so it can run over FleetSlice
+ * fields. The table is picked once at runtime from the best instruction set
+ * the CPU supports (AVX2, SSE4.1, or portable scalar).
+ */
+struct KinematicsKernels
+{
+    const char* name; // Instruction set name, e.g. "avx2"
+
+    /**
+     * @brief values[i] += (samples[i] - offset) * scale
+     */
+    void (*addScaled)(double* values, const double* samples, int count, double offset, double scale);
+
+    /**
+     * @brief values[i] = (samples[i] - offset) * scale
+     */
+    void (*setScaled)(double* values, const double* samples, int count, double offset, double scale);
+
+    /**
+     * @brief Branchlessly wrap headings into [0, 360)
+     */
+    void (*wrapHeadings)(double* headings, int count);
+};
+
+namespace Kinematics
+{
+/**
+ * @brief Instruction sets with a kernel implementation
+ */
+enum class Isa
+{
+    Scalar,
+    SSE41,
+    AVX2
+};
+
+// Strategies process slices in chunks of this many drones so scratch buffers stay in L1
+constexpr int CHUNK_SIZE = 256;
+
+/**
+ * @brief Get the best instruction set supported by this CPU
+ */
+Isa bestSupportedIsa();
+
+/**
+ * @brief Get the kernels for the best supported instruction set
+ */
+const KinematicsKernels& kernels();
+
+/**
+ * @brief Get the kernels for a specific instruction set (falls back to scalar if unsupported)
+ */
+const KinematicsKernels& kernels(Isa isa);
+}
+
+#endif // KINEMATICS_H
@@ -0,0 +1,116 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <QtGlobal>
+#include <QtAlgorithms>
+#include <atomic>
+
+/**
+ * @brief Lock-free log-linear latency histogram in the style of HdrHistogram
+ * Values are nanoseconds. Every power of two is split into SUB_BUCKET_COUNT / 2
+ * equal buckets, so a recorded value is known to within 1/64 (1.6%) of itself
+ * from 1 ns up to MAX_VALUE_NS, in a fixed 16 KB of counters. record() is a few
+ * relaxed atomic adds and may be called from any thread; readers see counts
+ * that are at most a few records behind.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr int SUB_BUCKET_BITS = 7;                          // log2 of the buckets per magnitude, counting both halves
+    static constexpr int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;      // Values below this get one bucket each
+    static constexpr int MAX_VALUE_BITS = 36;                          // Values are clamped below 2^36 ns (~68.7 s)
+    static constexpr qint64 MAX_VALUE_NS = (1ll << MAX_VALUE_BITS) - 1;
+    static constexpr int BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 2) << (SUB_BUCKET_BITS - 1);
+
+    /**
+     * @brief Percentiles and moments of a histogram, read in one pass
+     */
+    struct Summary
+    {
+        quint64 count = 0; // Recorded values
+        double mean = 0.0; // Mean in nanoseconds
+        qint64 p50 = 0;    // Median (ns)
+        qint64 p99 = 0;    // 99th percentile (ns)
+        qint64 p999 = 0;   // 99.9th percentile (ns)
+        qint64 max = 0;    // Largest recorded value (ns, exact)
+    };
+
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Record one duration; negative values count as 0, huge ones as MAX_VALUE_NS
+     */
+    void record(qint64 valueNs)
+    {
+        valueNs = qBound<qint64>(0, valueNs, MAX_VALUE_NS);
+        _counts[bucketIndex(valueNs)].fetch_add(1, std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _total.fetch_add(valueNs, std::memory_order_relaxed);
+
+        qint64 max = _max.load(std::memory_order_relaxed);
+        while (valueNs > max && !_max.compare_exchange_weak(max, valueNs, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /**
+     * @brief Clear all counts
+     */
+    void reset();
+
+    /**
+     * @brief Get the number of recorded values
+     */
+    quint64 getCount() const
+    {
+        return _count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the largest recorded value in nanoseconds
+     */
+    qint64 getMax() const
+    {
+        return _max.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the value at or below which the given percentage of values fall
+     * @param percentile Percentage in [0, 100]
+     * @return Upper bound of the bucket holding that value, in nanoseconds (0 if empty)
+     */
+    qint64 getValueAtPercentile(double percentile) const;
+
+    /**
+     * @brief Read count, mean, p50/p99/p999 and max together
+     */
+    Summary getSummary() const;
+
+    /**
+     * @brief Get the bucket that holds a value in [0, MAX_VALUE_NS]
+     */
+    static int bucketIndex(qint64 valueNs)
+    {
+        // Bucket width doubles with each power of two past SUB_BUCKET_COUNT
+        quint64 value = static_cast<quint64>(valueNs);
+        int magnitude = 63 - qCountLeadingZeroBits(value | (SUB_BUCKET_COUNT - 1));
+        int shift = magnitude - SUB_BUCKET_BITS + 1;
+        return (shift << (SUB_BUCKET_BITS - 1)) + static_cast<int>(value >> shift);
+    }
+
+    /**
+     * @brief Get the largest value that falls into a bucket
+     */
+    static qint64 bucketUpperBound(int index);
+
+private:
+    std::atomic<quint64> _counts[BUCKET_COUNT]; // Values per bucket
+    std::atomic<quint64> _count;                // Total recorded values
+    std::atomic<qint64> _total;                 // Sum of recorded values (ns)
+    std::atomic<qint64> _max;                   // Largest recorded value (ns)
+};
+
+#endif // LATENCYHISTOGRAM_H
@@ -7,11 +7,17 @@
 #include <QTextStream>
 #include <QMutex>
 #include <QDateTime>
+#include <QVector>
+#include <atomic>
+
+class QThread;
 
 /**
  * @brief Singleton Logger class for centralized, thread-safe logging
  * Provides logging functionality with different log levels
- * Logs are written to a file and the console
+ * Logs are written to a file and the console, either synchronously on the
+ * caller's thread or, in async mode, by a background writer thread fed from
+ * per-thread lock-free ring buffers.
  */
 class Logger : public QObject
 {
@@ -28,12 +34,56 @@ public:
         ERROR    // Error messages
     };
 
+    /**
+     * @brief What an async producer does when its ring buffer is full
+     */
+    enum OverflowPolicy {
+        DROP,  // Discard the record and count it as dropped
+        BLOCK  // Wait until the writer thread frees a slot
+    };
+
+    /**
+     * @brief Configuration for async logging
+     */
+    struct AsyncOptions {
+        int ringCapacity = 4096;                  // Records per producer thread (rounded up to a power of two)
+        int flushIntervalMs = 250;                // Longest time written records may sit unflushed
+        LogLevel flushLevel = WARNING;            // Records at or above this level are flushed immediately
+        OverflowPolicy overflowPolicy = DROP;     // Behaviour when a ring is full
+        bool echoToConsole = true;                // Mirror records to qDebug()
+    };
+
     /**
      * @brief Get the singleton instance of Logger
      * @return Reference to the Logger instance
      */
     static Logger& getInstance();
     
+    /**
+     * @brief Set the runtime minimum log level; messages below it are discarded
+     * Does not need the Logger instance, so it can be set before first use.
+     */
+    static void setMinimumLevel(LogLevel level)
+    {
+        _minimumLevel.store(level, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the runtime minimum log level
+     */
+    static LogLevel getMinimumLevel()
+    {
+        return static_cast<LogLevel>(_minimumLevel.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Check if messages at the given level are logged (one relaxed atomic load)
+     */
+    static bool isLevelEnabled(LogLevel level)
+    {
+        return level >= _minimumLevel.load(std::memory_order_relaxed);
+    }
+    
     /**
      * @brief Log a message with a specific log level
      * @param level The log level
@@ -41,6 +91,39 @@ public:
      */
     void log(LogLevel level, const QString& message);
     
+    /**
+     * @brief Switch to async mode with default options
+     */
+    void enableAsync();
+
+    /**
+     * @brief Switch to async mode: callers enqueue records, a writer thread formats and writes them
+     * @param options Ring size, flush and overflow policy
+     */
+    void enableAsync(const AsyncOptions& options);
+
+    /**
+     * @brief Drain pending records, stop the writer thread and return to synchronous logging
+     * Waits for producers already pushing a record, so no record logged before the call returns is lost.
+     */
+    void disableAsync();
+
+    /**
+     * @brief Check if async mode is active
+     */
+    bool isAsync() const
+    {
+        return _asyncEnabled.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the number of records dropped because a ring buffer was full
+     */
+    quint64 getDroppedCount() const
+    {
+        return _droppedCount.load(std::memory_order_relaxed);
+    }
+    
     /**
      * @brief Log a debug message
      * @param message The message to log
@@ -66,6 +149,10 @@ public:
     void error(const QString& message);
 
 private:
+    struct LogRecord;
+    struct LogRing;
+    struct RingLease;
+
     /**
      * @brief Private constructor for singleton pattern
      */
@@ -85,16 +172,93 @@ private:
      * @return String representation of the log level
      */
     QString levelToString(LogLevel level);
+
+    /**
+     * @brief Format a log line as "[timestamp] [level] message"
+     */
+    QString formatMessage(qint64 timestampMs, LogLevel level, const QString& message);
+
+    /**
+     * @brief Write a formatted line to the file and console (caller holds _mutex)
+     */
+    void writeLine(const QString& line, bool echoToConsole);
+
+    /**
+     * @brief Enqueue a record on the calling thread's ring buffer
+     * @return false if the record could not be queued and must be written synchronously
+     */
+    bool enqueue(LogLevel level, const QString& message);
+
+    /**
+     * @brief Get (creating on first use) the calling thread's ring buffer
+     */
+    LogRing* threadRing();
+
+    /**
+     * @brief Move every queued record into the batch, ordered by timestamp
+     * @return true if the batch contains a record at or above the flush level
+     */
+    bool drainRings(QVector<LogRecord>& batch);
+
+    /**
+     * @brief Format and write a batch of records, flushing if required
+     */
+    void writeBatch(QVector<LogRecord>& batch, bool forceFlush);
+
+    /**
+     * @brief Writer thread main loop
+     */
+    void writerLoop();
     
     QFile _logFile;           // Log file handle
     QTextStream _logStream;   // Log file stream
-    QMutex _mutex;            // Mutex for thread safety
+    QMutex _mutex;            // Mutex for thread safety (file writes, ring registry)
     static Logger* _instance; // Singleton instance pointer
+    static std::atomic<int> _minimumLevel; // Runtime minimum log level
+
+    AsyncOptions _asyncOptions;             // Active async configuration (guarded by _mutex; fixed while the writer runs)
+    std::atomic<int> _overflowPolicy;       // _asyncOptions.overflowPolicy, read by producers without the lock
+    QVector<LogRing*> _rings;               // Per-thread ring buffers; an exited thread's ring is reused (guarded by _mutex)
+    QThread* _writerThread;                 // Background writer thread
+    std::atomic<bool> _asyncEnabled;        // Async mode flag
+    std::atomic<bool> _stopWriter;          // Writer shutdown request
+    std::atomic<quint64> _droppedCount;     // Records dropped on overflow
+    quint64 _reportedDropCount;             // Drops already reported in the log
+    qint64 _lastFlushMs;                    // Time of the last async flush
 };
 
-#define LOG_DEBUG(msg) Logger::getInstance().debug(msg)
-#define LOG_INFO(msg) Logger::getInstance().info(msg)
-#define LOG_WARNING(msg) Logger::getInstance().warning(msg)
-#define LOG_ERROR(msg) Logger::getInstance().error(msg)
+// Compile-time minimum log level (0 = DEBUG, 1 = INFO, 2 = WARNING, 3 = ERROR).
+// Calls below it compile to nothing; set through the LOG_MIN_LEVEL CMake cache variable.
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#endif
+
+// The message expression is only evaluated when the level is enabled at runtime
+#define LOG_AT_LEVEL(level, msg) \
+    do { if (Logger::isLevelEnabled(level)) Logger::getInstance().log(level, msg); } while (0)
+
+// Type-checks the message but never evaluates it
+#define LOG_DISABLED(level, msg) \
+    do { if (false) Logger::getInstance().log(level, msg); } while (0)
+
+#if LOG_MIN_LEVEL <= 0
+#define LOG_DEBUG(msg) LOG_AT_LEVEL(Logger::DEBUG, msg)
+#else
+#define LOG_DEBUG(msg) LOG_DISABLED(Logger::DEBUG, msg)
+#endif
+
+#if LOG_MIN_LEVEL <= 1
+#define LOG_INFO(msg) LOG_AT_LEVEL(Logger::INFO, msg)
+#else
+#define LOG_INFO(msg) LOG_DISABLED(Logger::INFO, msg)
+#endif
+
+#if LOG_MIN_LEVEL <= 2
+#define LOG_WARNING(msg) LOG_AT_LEVEL(Logger::WARNING, msg)
+#else
+#define LOG_WARNING(msg) LOG_DISABLED(Logger::WARNING, msg)
+#endif
+
+#define LOG_ERROR(msg) LOG_AT_LEVEL(Logger::ERROR, msg)
 
 #endif // LOGGER_H 
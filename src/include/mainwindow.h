@@ -7,9 +7,18 @@
 #include <QPushButton>
 #include <QComboBox>
 #include <QAction>
+#include <QTimer>
+#include <QPalette>
+#include <QModelIndex>
+#include "telemetrytypes.h"
 
 class TelemetryModel;
 class DroneSimulator;
+class TelemetrySnapshotBuffer;
+class FleetTableModel;
+class TelemetryReplay;
+class ProfilerPanel;
+class Drone;
 
 QT_BEGIN_NAMESPACE
 namespace Ui
@@ -38,11 +47,65 @@ public:
      */
     ~MainWindow();
 
+    static constexpr int DEFAULT_REFRESH_RATE_HZ = 60; // Default display refresh rate
+    static constexpr int MAX_REFRESH_RATE_HZ = 240;    // Highest accepted refresh rate
+    static constexpr int REPLAY_SLIDER_STEPS = 1000;   // Replay slider resolution over the recording
+
+    /**
+     * @brief Set how often the telemetry display is refreshed, independent of the tick rate
+     * @param hz Refreshes per second, clamped to [1, MAX_REFRESH_RATE_HZ]
+     */
+    void setRefreshRate(int hz);
+
+    /**
+     * @brief Get the telemetry display refresh rate in Hz
+     */
+    int getRefreshRate() const
+    {
+        return _refreshRateHz;
+    }
+
+    /**
+     * @brief Grow the simulated fleet to the given number of drones
+     */
+    void setFleetSize(int droneCount);
+
+    /**
+     * @brief Stop the simulation and show a telemetry recording instead, paused at its start
+     * @return False (after warning the user) if the file is not a readable recording
+     */
+    bool openRecording(const QString& path);
+
+    /**
+     * @brief Close the open recording and return to the live simulation
+     */
+    void closeRecording();
+
 private slots:
     /**
-     * @brief Update the UI when telemetry data changes
+     * @brief Refresh clock tick: show the latest snapshot if anything changed since the last frame
      */
-    void onTelemetryUpdated();
+    void onRefreshTimeout();
+
+    /**
+     * @brief Handle a new current drone: rewire its signals and show it in detail
+     */
+    void onDroneChanged(Drone* drone);
+
+    /**
+     * @brief Handle GPS filter combo box change
+     */
+    void onGpsFilterComboBoxChanged(int index);
+
+    /**
+     * @brief Make the drone in the selected fleet table row the current drone
+     */
+    void onFleetRowChanged(const QModelIndex& current, const QModelIndex& previous);
+
+    /**
+     * @brief Select the current drone's row in the fleet table, if it is shown
+     */
+    void selectCurrentDroneRow();
 
     /**
      * @brief Handle simulation started event
@@ -89,6 +152,51 @@ private slots:
      */
     void onGpsFixLost();
     
+    /**
+     * @brief Ask for a recording file and open it
+     */
+    void onActionOpenRecording();
+
+    /**
+     * @brief Handle close recording menu action
+     */
+    void onActionCloseRecording();
+
+    /**
+     * @brief Toggle replay playback
+     */
+    void onReplayPlayButtonClicked();
+
+    /**
+     * @brief Apply the replay speed chosen in the combo box (e.g. "-2x")
+     */
+    void onReplaySpeedComboBoxChanged(int index);
+
+    /**
+     * @brief Scrub the replay to the slider position
+     */
+    void onReplaySliderChanged(int value);
+
+    /**
+     * @brief Follow the replay position with the slider and time label
+     */
+    void onReplayPositionChanged(double simulationTime);
+
+    /**
+     * @brief Update the play button when replay playback starts or stops
+     */
+    void onReplayPlayingChanged(bool playing);
+    
+    /**
+     * @brief Show the tick profiler panel
+     */
+    void onActionTickProfiler();
+
+    /**
+     * @brief Ask for a file and write the last seconds of trace events to it
+     */
+    void onActionSaveTrace();
+    
     /**
      * @brief Handle exit menu action
      */
@@ -103,6 +211,30 @@ private:
     Ui::MainWindow* ui;                // UI object generated by Qt Designer
     TelemetryModel* _telemetryModel;   // Pointer to the telemetry model
     DroneSimulator* _simulator;        // Pointer to the drone simulator
+    TelemetrySnapshotBuffer* _snapshotBuffer; // UI's snapshot buffer, owned by the model
+    FleetTableModel* _fleetTableModel; // Fleet overview table model
+    TelemetryReplay* _replay;          // Recording playback, shown instead of the simulation when open
+    ProfilerPanel* _profilerPanel;     // Tick profiler panel, created when first shown
+    QTimer* _refreshTimer;             // Display refresh clock
+    int _refreshRateHz;                // Display refresh rate
+    
+    /**
+     * @brief Battery colour bands, also indexes into _batteryPalettes
+     */
+    enum BatteryBand
+    {
+        BATTERY_GREEN,
+        BATTERY_YELLOW,
+        BATTERY_RED,
+        BATTERY_BAND_COUNT
+    };
+    
+    static constexpr int GPS_FIX_STATUS_COUNT = 3; // Number of GPSFixStatus values
+    
+    QPalette _batteryPalettes[BATTERY_BAND_COUNT];   // Progress bar palette per battery band
+    QPalette _gpsFixPalettes[GPS_FIX_STATUS_COUNT];  // GPS label palette per GPSFixStatus
+    int _batteryBand;                  // Band currently shown (-1 = none yet)
+    int _gpsFixStatus;                 // GPSFixStatus currently shown (-1 = none yet)
     
     // Observer pattern implementation
     /**
@@ -111,9 +243,41 @@ private:
     void setupConnections();
 
     /**
-     * @brief Update all telemetry display fields in the UI
+     * @brief Create the fleet table model and configure the table view for large fleets
+     */
+    void setupFleetTable();
+
+    /**
+     * @brief Switch the controls between live simulation and replay
+     */
+    void setReplayMode(bool replaying);
+
+    /**
+     * @brief Connect a drone's warning signals to the UI
+     */
+    void connectDroneSignals(Drone* drone);
+
+    /**
+     * @brief Pick up the latest snapshot and refresh the fleet table and detail labels
+     * @param changedFields TelemetryField bits to refresh in addition to those published since the last call
+     */
+    void refreshFromSnapshot(quint32 changedFields);
+
+    /**
+     * @brief Show the current snapshot in the fleet table, refreshing only the rows on screen
+     */
+    void updateFleetTable();
+
+    /**
+     * @brief Update the telemetry detail labels from the current snapshot
+     * @param changedFields TelemetryField bits of the labels to refresh
+     */
+    void updateTelemetryDisplay(quint32 changedFields);
+
+    /**
+     * @brief Set a label's text only if the formatted value differs from what it shows
      */
-    void updateTelemetryDisplay();
+    static void setLabelText(QLabel* label, const QString& text);
 
     /**
      * @brief Update the status display in the UI
@@ -121,14 +285,19 @@ private:
     void updateStatusDisplay();
 
     /**
-     * @brief Update the battery display in the UI
+     * @brief Build the battery and GPS palettes once, so updates only swap between them
+     */
+    void initializeDisplayPalettes();
+
+    /**
+     * @brief Update the battery display in the UI; the colour changes only when the band does
      */
-    void updateBatteryDisplay();
+    void updateBatteryDisplay(int battery);
 
     /**
-     * @brief Update the GPS fix display in the UI
+     * @brief Update the GPS fix display in the UI; text and colour change only on a status transition
      */
-    void updateGpsFixDisplay();
+    void updateGpsFixDisplay(GPSFixStatus status);
     
     /**
      * @brief Set the status message in the UI
@@ -3,10 +3,24 @@
 
 #include <QObject>
 #include <QString>
+#include <cmath>
+
+#include "fleetstate.h"
+#include "counterrng.h"
 
 // Forward declarations
 class Drone;
 
+/**
+ * @brief Per-tick inputs shared by every strategy invocation within a tick
+ */
+struct TickContext
+{
+    quint64 tick = 0; // Simulation tick being computed
+    CounterRng rng;   // Counter-based generator keyed by the simulation seed
+    double dt = 0.5;  // Simulated seconds covered by this tick
+};
+
 /**
  * @brief Abstract base class for drone movement strategies (Strategy Pattern)
  * Subclasses implement specific movement behaviors for the drone simulation
@@ -28,10 +42,21 @@ public:
     virtual ~MovementStrategy() = default;
     
     /**
-     * @brief Update the drone's position according to the strategy
+     * @brief Update the positions of every drone in the slice according to the strategy
+     * Implementations loop over the slice's arrays directly; no signals are emitted.
+     * @param slice View over the fleet slots to update
+     * @param context Tick number and random generator for this tick
+     */
+    virtual void updatePositions(const FleetSlice& slice, const TickContext& context) = 0;
+
+    /**
+     * @brief Update a single drone's position according to the strategy
+     * Adapter over updatePositions() for a one-slot slice; emits the drone's
+     * telemetryUpdated signal once for all kinematic fields.
      * @param drone Pointer to the drone to update
+     * @param context Tick number and random generator for this tick
      */
-    virtual void updatePosition(Drone* drone) = 0;
+    void updatePosition(Drone* drone, const TickContext& context);
 
     /**
      * @brief Get the name of the strategy
@@ -39,6 +64,36 @@ public:
      */
     virtual QString getStrategyName() const = 0;
     
+    /**
+     * @brief Step length the strategies' per-tick noise amplitudes were tuned for
+     */
+    static constexpr double REFERENCE_STEP_SECONDS = 0.5;
+
+    /**
+     * @brief Random streams, one per quantity drawn for each drone from the simulation seed
+     * Strategies draw the movement streams every tick. DroneFactory draws the
+     * spawn streams for disk placement at tick 0; they need their own numbers,
+     * or spawn positions would repeat the tick-0 movement noise.
+     */
+    enum RandomStream : quint32
+    {
+        LATITUDE_STREAM,
+        LONGITUDE_STREAM,
+        ALTITUDE_STREAM,
+        HEADING_STREAM,
+        SPEED_STREAM,
+        SPAWN_DISTANCE_STREAM, // Disk spawn: distance from the centre
+        SPAWN_BEARING_STREAM   // Disk spawn: bearing from the centre
+    };
+
+protected:
+    /**
+     * @brief Scale factor for random-walk noise over a step of dt seconds
+     * Noise variance grows linearly with time, so amplitudes scale with
+     * sqrt(dt); a walk looks the same whatever step length it is run at.
+     */
+    static double noiseScale(double dt) { return std::sqrt(dt / REFERENCE_STEP_SECONDS); }
+
 signals:
     /**
      * @brief Emitted when the strategy changes
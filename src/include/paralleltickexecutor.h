@@ -0,0 +1,93 @@
+#ifndef PARALLELTICKEXECUTOR_H
+#define PARALLELTICKEXECUTOR_H
+
+#include <QtGlobal>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+class QThread;
+
+/**
+ * @brief Work-stealing thread pool that runs one batch of tasks per simulation tick
+ * run() splits the task indices evenly across the workers (the calling thread
+ * is worker 0). Each worker takes tasks from the front of its own range; a worker
+ * that runs dry steals half of the remaining range of another worker, so uneven
+ * task costs still balance. run() returns only after every task has finished and
+ * every worker is idle again, which is the per-tick barrier.
+ */
+class ParallelTickExecutor
+{
+public:
+    /**
+     * @brief Construct an executor
+     * @param threadCount Number of threads including the caller (0 = one per core)
+     */
+    explicit ParallelTickExecutor(int threadCount = 0);
+    ~ParallelTickExecutor();
+
+    ParallelTickExecutor(const ParallelTickExecutor&) = delete;
+    ParallelTickExecutor& operator=(const ParallelTickExecutor&) = delete;
+
+    /**
+     * @brief Get the number of threads that execute tasks, including the caller
+     */
+    int getThreadCount() const
+    {
+        return _threadCount;
+    }
+
+    /**
+     * @brief Run task(0) ... task(taskCount - 1) across the pool and wait for all of them
+     * Tasks must be independent of each other; they may run in any order and on any worker.
+     */
+    void run(int taskCount, const std::function<void(int)>& task);
+
+private:
+    /**
+     * @brief Range of task indices owned by one worker, packed as (begin << 32 | end)
+     * Owner and thieves both update it with compare-and-swap, so no lock is needed.
+     */
+    struct alignas(64) TaskQueue
+    {
+        std::atomic<quint64> range{0};
+    };
+
+    int _threadCount;                      // Workers including the calling thread
+    std::unique_ptr<TaskQueue[]> _queues;  // Task range per worker
+    QVector<QThread*> _threads;            // Pool threads (workers 1..n-1)
+    const std::function<void(int)>* _task; // Task of the batch in flight
+    int _activeWorkers;                    // Pool workers still inside the batch (guarded by _mutex)
+    quint64 _generation;                   // Batch counter, bumped by run() (guarded by _mutex)
+    bool _stopping;                        // Shutdown request (guarded by _mutex)
+    QMutex _mutex;                         // Guards the batch hand-off
+    QWaitCondition _batchReady;            // Wakes pool workers when a batch starts
+    QWaitCondition _batchDone;             // Wakes run() when the last worker goes idle
+
+    /**
+     * @brief Pool thread main loop: wait for a batch, help drain it, repeat
+     */
+    void workerLoop(int worker);
+
+    /**
+     * @brief Run tasks from the worker's own range, then steal until every range is empty
+     */
+    void drain(int worker);
+
+    /**
+     * @brief Take the next task from the front of the worker's own range
+     * @return Task index, or -1 if the range is empty
+     */
+    int popOwn(int worker);
+
+    /**
+     * @brief Move the back half of another worker's range into this worker's range
+     * @return True if anything was stolen
+     */
+    bool steal(int worker);
+};
+
+#endif // PARALLELTICKEXECUTOR_H
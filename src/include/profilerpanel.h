@@ -0,0 +1,51 @@
+#ifndef PROFILERPANEL_H
+#define PROFILERPANEL_H
+
+#include <QDialog>
+
+class TickProfiler;
+class QPlainTextEdit;
+class QTimer;
+
+/**
+ * @brief Debug panel that shows the tick profiler's per-phase latency table
+ * Non-modal; refreshes itself while it is visible and can reset the
+ * histograms or save the table to a file.
+ */
+class ProfilerPanel : public QDialog
+{
+    Q_OBJECT
+
+public:
+    static constexpr int REFRESH_INTERVAL_MS = 500; // Table refresh period while visible
+
+    /**
+     * @brief Construct a panel for a profiler
+     * @param profiler Profiler to show (not owned)
+     * @param parent The parent widget
+     */
+    ProfilerPanel(TickProfiler* profiler, QWidget* parent = nullptr);
+
+private slots:
+    /**
+     * @brief Show the profiler's current report if the panel is visible
+     */
+    void refresh();
+
+    /**
+     * @brief Clear the profiler's histograms
+     */
+    void onResetButtonClicked();
+
+    /**
+     * @brief Ask for a file and write the report to it
+     */
+    void onSaveButtonClicked();
+
+private:
+    TickProfiler* _profiler;     // Profiler shown
+    QPlainTextEdit* _reportView; // Report table
+    QTimer* _refreshTimer;       // Refresh clock
+};
+
+#endif // PROFILERPANEL_H
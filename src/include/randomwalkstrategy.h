@@ -19,10 +19,11 @@ public:
     explicit RandomWalkStrategy(QObject* parent = nullptr);
     
     /**
-     * @brief Update the drone's position using a random walk algorithm
-     * @param drone Pointer to the drone to update
+     * @brief Update the positions of all drones in the slice using a random walk algorithm
+     * @param slice View over the fleet slots to update
+     * @param context Tick number and random generator for this tick
      */
-    void updatePosition(Drone* drone) override;
+    void updatePositions(const FleetSlice& slice, const TickContext& context) override;
 
     /**
      * @brief Get the name of this strategy
@@ -0,0 +1,156 @@
+#ifndef SEPARATIONMONITOR_H
+#define SEPARATIONMONITOR_H
+
+#include <QMetaType>
+#include <QVector>
+#include "telemetrytypes.h"
+
+class FleetState;
+class ParallelTickExecutor;
+class SpatialIndex;
+
+/**
+ * @brief Two drones closer than the separation minima
+ */
+struct SeparationConflict
+{
+    int firstSlot;             // Fleet slot of the first drone (the lower slot)
+    int secondSlot;            // Fleet slot of the second drone
+    DroneId firstId;           // Interned ID of the first drone
+    DroneId secondId;          // Interned ID of the second drone
+    double horizontalDistance; // Horizontal separation (m)
+    double verticalDistance;   // Altitude difference (m)
+};
+
+Q_DECLARE_METATYPE(SeparationConflict)
+
+/**
+ * @brief Per-tick detector of separation violations between drones
+ * Two drones are in conflict when they are closer than the horizontal minimum
+ * and, at the same time, closer in altitude than the vertical minimum.
+ *
+ * detect() uses the SpatialIndex of the same tick as its broad phase: each
+ * drone only looks at the cells within the horizontal minimum of it, so the
+ * cost grows with the fleet and the local density instead of with every pair
+ * (a cluster of k drones still costs k^2 checks, since that many conflicts are
+ * possible). The fleet is split into chunks checked in parallel, and every
+ * pair is checked once, from its lower slot. Conflicts are tracked by drone
+ * ID from tick to tick, so each one is reported as new only on the tick it
+ * starts, however the fleet is reordered meanwhile. Beyond
+ * MAX_REPORTED_CONFLICTS, conflicts are only counted: one that starts there
+ * is reported when it is first kept, and one already reported stays tracked.
+ */
+class SeparationMonitor
+{
+public:
+    static constexpr double DEFAULT_HORIZONTAL_MINIMUM = 30.0; // Horizontal separation minimum (m)
+    static constexpr double DEFAULT_VERTICAL_MINIMUM = 10.0;   // Vertical separation minimum (m)
+    static constexpr int DETECT_CHUNK_SIZE = 2048;             // Drones per parallel detection task
+    static constexpr int MAX_REPORTED_CONFLICTS = 65536;       // Conflicts kept per tick; the rest are only counted
+
+    /**
+     * @brief Construct a monitor with no conflicts
+     */
+    SeparationMonitor(double horizontalMinimum = DEFAULT_HORIZONTAL_MINIMUM,
+                      double verticalMinimum = DEFAULT_VERTICAL_MINIMUM);
+
+    /**
+     * @brief Set the separation minima in metres; non-positive values are ignored
+     */
+    void setMinima(double horizontalMinimum, double verticalMinimum);
+
+    /**
+     * @brief Get the horizontal separation minimum in metres
+     */
+    double getHorizontalMinimum() const
+    {
+        return _horizontalMinimum;
+    }
+
+    /**
+     * @brief Get the vertical separation minimum in metres
+     */
+    double getVerticalMinimum() const
+    {
+        return _verticalMinimum;
+    }
+
+    /**
+     * @brief Find every pair of drones in conflict
+     * @param fleet Fleet whose altitudes and IDs to use
+     * @param index Index updated from the same fleet this tick (horizontal positions and broad phase)
+     * @param executor Pool to spread the work over (nullptr = calling thread only)
+     */
+    void detect(const FleetState& fleet, const SpatialIndex& index, ParallelTickExecutor* executor = nullptr);
+
+    /**
+     * @brief Forget every conflict, so the next detect() reports all of them as new
+     */
+    void reset();
+
+    /**
+     * @brief Get the conflicts found by the last detect(), ordered by slots
+     * At most MAX_REPORTED_CONFLICTS, the ones with the lowest slots.
+     */
+    const QVector<SeparationConflict>& getConflicts() const
+    {
+        return _conflicts;
+    }
+
+    /**
+     * @brief Get the conflicts of the last detect() that were not there the detect() before
+     */
+    const QVector<SeparationConflict>& getNewConflicts() const
+    {
+        return _newConflicts;
+    }
+
+    /**
+     * @brief Get the number of conflicts found by the last detect(), including any not kept
+     */
+    qint64 getConflictCount() const
+    {
+        return _conflictCount;
+    }
+
+    /**
+     * @brief Get the number of conflicts that started since the last reset()
+     */
+    quint64 getStartedCount() const
+    {
+        return _startedCount;
+    }
+
+private:
+    /**
+     * @brief Key a pair of drones independently of their order and slots
+     */
+    static quint64 pairKey(DroneId first, DroneId second)
+    {
+        return first < second ? (static_cast<quint64>(first) << 32) | second
+                              : (static_cast<quint64>(second) << 32) | first;
+    }
+
+    /**
+     * @brief Check the drones of one chunk against their neighbours (runs on a tick worker)
+     * @param found Receives the chunk's conflicts with the lowest slots, at most MAX_REPORTED_CONFLICTS
+     * @param carriedKeys Receives the pair keys of conflicts not kept in found that are already tracked
+     * @return Number of conflicts found, including any beyond MAX_REPORTED_CONFLICTS
+     */
+    qint64 detectChunk(const FleetState& fleet, const SpatialIndex& index, int begin, int end,
+                       QVector<SeparationConflict>& found, QVector<quint64>& carriedKeys) const;
+
+    double _horizontalMinimum;          // Horizontal separation minimum (m)
+    double _verticalMinimum;            // Vertical separation minimum (m)
+    QVector<SeparationConflict> _conflicts;    // Conflicts of the last detect()
+    QVector<SeparationConflict> _newConflicts; // Conflicts that started at the last detect()
+    QVector<QVector<SeparationConflict>> _chunkConflicts; // Per-task results, kept to reuse their memory
+    QVector<QVector<quint64>> _chunkCarriedKeys; // Per-task keys of tracked conflicts not kept
+    QVector<qint64> _chunkCounts;       // Per-task conflict counts
+    QVector<quint64> _activeKeys;       // Sorted pair keys tracked after the last detect()
+    QVector<quint64> _previousKeys;     // Sorted pair keys of the detect() before
+    qint64 _conflictCount;              // Conflicts found by the last detect()
+    quint64 _startedCount;              // Conflicts started since reset()
+};
+
+#endif // SEPARATIONMONITOR_H
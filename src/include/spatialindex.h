@@ -0,0 +1,257 @@
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include <QVector>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+
+class FleetState;
+class ParallelTickExecutor;
+
+/**
+ * @brief Uniform-grid index over fleet positions for proximity queries
+ * Positions are projected onto a local plane in metres (equirectangular
+ * around a reference point at the centre of the fleet, accurate to well
+ * under a percent over tens of kilometres) and bucketed into square cells.
+ * The reference moves back to the centre of the fleet's bounding box whenever
+ * the fleet's slots change or the fleet has flown 10 km away from it. Cells are
+ * hashed into a bucket table and drone slots stored bucket by bucket, so
+ * memory is linear in the fleet however far it spreads.
+ *
+ * update() runs once per tick over the whole fleet in parallel: it projects
+ * every drone and re-buckets the fleet with a parallel counting sort only
+ * when the fleet changed. Drones that merely changed cell are listed apart,
+ * sorted by bucket, and merged in by queries until more than an eighth of the
+ * fleet is listed, so steady flight does not re-bucket everyone every tick.
+ * Queries use the positions of the last update and are safe from any number
+ * of threads between updates.
+ */
+class SpatialIndex
+{
+public:
+    static constexpr double DEFAULT_CELL_SIZE = 50.0; // Cell edge in metres
+    static constexpr int UPDATE_CHUNK_SIZE = 4096;    // Drones per parallel update task
+
+    /**
+     * @brief Construct an empty index
+     * @param cellSize Cell edge in metres; queries cost least when it is close to the usual query radius
+     */
+    explicit SpatialIndex(double cellSize = DEFAULT_CELL_SIZE);
+
+    SpatialIndex(const SpatialIndex&) = delete;
+    SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+    /**
+     * @brief Set the cell edge in metres; the next update() rebuilds the index
+     */
+    void setCellSize(double cellSize);
+
+    /**
+     * @brief Get the cell edge in metres
+     */
+    double getCellSize() const
+    {
+        return _cellSize;
+    }
+
+    /**
+     * @brief Bring the index up to date with the fleet's positions
+     * @param fleet Fleet to index
+     * @param executor Pool to spread the work over (nullptr = calling thread only)
+     */
+    void update(const FleetState& fleet, ParallelTickExecutor* executor = nullptr);
+
+    /**
+     * @brief Forget every drone and the reference point
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of indexed drones
+     */
+    int size() const
+    {
+        return _count;
+    }
+
+    /**
+     * @brief Check if the last update() had to re-bucket every drone
+     */
+    bool wasRebuilt() const
+    {
+        return _rebuilt;
+    }
+
+    /**
+     * @brief Project a position onto the index's local plane
+     * @param x Metres east of the reference point
+     * @param y Metres north of the reference point
+     */
+    void toLocal(double latitude, double longitude, double& x, double& y) const;
+
+    /**
+     * @brief Get the indexed drones' local east coordinates (metres), one per slot
+     */
+    const double* xs() const
+    {
+        return _x.constData();
+    }
+
+    /**
+     * @brief Get the indexed drones' local north coordinates (metres), one per slot
+     */
+    const double* ys() const
+    {
+        return _y.constData();
+    }
+
+    /**
+     * @brief Get the cell column or row containing a local coordinate
+     */
+    int cellCoordinate(double metres) const;
+
+    /**
+     * @brief Call visit(slot) for every drone in a cell, in slot order
+     */
+    template <typename Visitor>
+    void forEachInCell(int cellX, int cellY, Visitor visit) const
+    {
+        if (_count == 0)
+        {
+            return;
+        }
+        quint64 key = cellKey(cellX, cellY);
+        int bucket = bucketOf(key);
+        const int* entry = _entries.constData() + _bucketStart[bucket];
+        const int* entriesEnd = _entries.constData() + _bucketStart[bucket + 1];
+        if (_moved.isEmpty())
+        {
+            for (; entry < entriesEnd; ++entry)
+            {
+                if (_cellKeys[*entry] == key) // Other cells can share the bucket
+                {
+                    visit(*entry);
+                }
+            }
+            return;
+        }
+
+        // Drones that left their cell since the last rebuild are skipped in their old
+        // bucket and merged in from the moved list, keeping slot order
+        quint64 movedKey = static_cast<quint64>(bucket) << 32;
+        const quint64* moved = std::lower_bound(_moved.constData(), _moved.constData() + _moved.size(), movedKey);
+        const quint64* movedEnd = std::lower_bound(moved, _moved.constData() + _moved.size(), movedKey + (1ull << 32));
+        while (entry < entriesEnd || moved < movedEnd)
+        {
+            int movedSlot = moved < movedEnd ? static_cast<int>(*moved & 0xFFFFFFFFu) : std::numeric_limits<int>::max();
+            if (entry < entriesEnd && *entry < movedSlot)
+            {
+                int slot = *entry++;
+                if (_cellKeys[slot] == key && _bucketedKeys[slot] == key)
+                {
+                    visit(slot);
+                }
+            }
+            else
+            {
+                ++moved;
+                if (_cellKeys[movedSlot] == key)
+                {
+                    visit(movedSlot);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Find the drones within a horizontal distance of a point
+     * @param result Receives the slots, in ascending order (cleared first)
+     */
+    void queryRadius(double latitude, double longitude, double radiusMetres, QVector<int>& result) const;
+
+    /**
+     * @brief Find the drones inside a latitude/longitude box
+     * @param result Receives the slots, in ascending order (cleared first)
+     */
+    void queryBox(double minLatitude, double minLongitude, double maxLatitude, double maxLongitude,
+                  QVector<int>& result) const;
+
+    /**
+     * @brief Find the drone horizontally closest to a point, e.g. the one under the cursor
+     * @return Its slot, or -1 if no drone is within maxDistanceMetres
+     */
+    int nearest(double latitude, double longitude, double maxDistanceMetres) const;
+
+private:
+    /**
+     * @brief Pack a cell's column and row into one key
+     */
+    static quint64 cellKey(int cellX, int cellY)
+    {
+        return (static_cast<quint64>(static_cast<quint32>(cellX)) << 32) | static_cast<quint32>(cellY);
+    }
+
+    /**
+     * @brief Get the bucket a cell key hashes to
+     */
+    int bucketOf(quint64 key) const
+    {
+        // Multiplicative hashing: the high bits mix both coordinates
+        return static_cast<int>((key * 0x9E3779B97F4A7C15ull) >> (64 - _bucketBits));
+    }
+
+    /**
+     * @brief Visit every drone in the cells overlapping a local rectangle
+     */
+    void forEachInRect(double minX, double minY, double maxX, double maxY, const std::function<void(int)>& visit) const;
+
+    /**
+     * @brief Run task(0) ... task(taskCount - 1) on the executor, or inline without one
+     */
+    static void runTasks(ParallelTickExecutor* executor, int taskCount, const std::function<void(int)>& task);
+
+    /**
+     * @brief Project every drone onto the local plane and compute its cell key
+     * @param bounds Receives the fleet's local bounding box: min x, max x, min y, max y
+     * @return True if some drone's cell key changed
+     */
+    bool project(const FleetState& fleet, ParallelTickExecutor* executor, double* bounds);
+
+    /**
+     * @brief Re-bucket every drone by its cell key (parallel counting sort)
+     */
+    void rebuild(ParallelTickExecutor* executor);
+
+    /**
+     * @brief List the drones outside the cell they were bucketed in, by bucket
+     * @return False if there are too many and the index should be rebuilt instead
+     */
+    bool listMoved(ParallelTickExecutor* executor);
+
+    double _cellSize;                   // Cell edge (m)
+    double _referenceLatitude;          // Origin of the local plane
+    double _referenceLongitude;
+    double _metresPerDegreeLongitude;   // East-west scale at the reference latitude
+    bool _hasReference;                 // Reference point fixed since the last clear()
+    int _count;                         // Indexed drones
+    quint32 _layoutVersion;             // FleetState layout the entries were built for
+    bool _rebuilt;                      // Last update re-bucketed
+    bool _stale;                        // Next update must re-bucket (cell size changed, cleared)
+    QVector<double> _x;                 // Local east coordinate per slot (m)
+    QVector<double> _y;                 // Local north coordinate per slot (m)
+    QVector<quint64> _cellKeys;         // Cell key per slot
+    QVector<double> _chunkBounds;       // Local bounding box of each update task's drones
+    int _bucketBits;                    // log2 of the bucket count
+    QVector<int> _bucketStart;          // First entry of each bucket, plus the end
+    QVector<int> _entries;              // Slots, grouped by bucket and ascending within it
+    QVector<quint64> _bucketedKeys;     // Cell key each slot was bucketed under by the last rebuild
+    QVector<quint64> _moved;            // (bucket << 32) | slot of each drone outside its bucketed cell, sorted
+    QVector<QVector<quint64>> _chunkMoved; // Per-task moved lists, kept to reuse their memory
+    std::unique_ptr<std::atomic<int>[]> _bucketFill; // Per-bucket counters for the parallel counting sort
+    int _bucketFillCapacity;            // Length of _bucketFill
+};
+
+#endif // SPATIALINDEX_H
@@ -0,0 +1,42 @@
+#ifndef STRATEGYFACTORY_H
+#define STRATEGYFACTORY_H
+
+#include <QString>
+
+class MovementStrategy;
+
+/**
+ * @brief Hands out shared movement strategy instances
+ * Strategies keep no per-drone state (all randomness comes from the tick's
+ * counter-based generator), so one instance of each kind serves every model,
+ * drone and thread. Switching strategies reuses these instead of allocating.
+ */
+class StrategyFactory
+{
+public:
+    /**
+     * @brief Kinds of strategy, in the order of the GUI's strategy combo box
+     */
+    enum StrategyType
+    {
+        HOVER_STRATEGY,
+        RANDOM_WALK_STRATEGY,
+        STRATEGY_TYPE_COUNT
+    };
+
+    StrategyFactory() = delete;
+
+    /**
+     * @brief Get the shared instance of a strategy (created on first use, never deleted)
+     * @return The strategy, or nullptr for an unknown type
+     */
+    static MovementStrategy* getSharedStrategy(StrategyType type);
+
+    /**
+     * @brief Look up a strategy type by its command-line name ("hover", "randomwalk")
+     * @return The type, or STRATEGY_TYPE_COUNT if the name is unknown
+     */
+    static StrategyType strategyTypeFromName(const QString& name);
+};
+
+#endif // STRATEGYFACTORY_H
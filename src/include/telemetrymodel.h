@@ -3,14 +3,31 @@
 
 #include <QObject>
 #include <QList>
-#include <QTimer>
+#include <QMutex>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "fleetstate.h"
+#include "separationmonitor.h"
+#include "spatialindex.h"
+#include "telemetrysnapshotbuffer.h"
+#include "tickprofiler.h"
+#include "counterrng.h"
 
 // Forward declarations
 class Drone;
+class DronePool;
 class MovementStrategy;
+class ParallelTickExecutor;
+class TelemetryRecorder;
+struct SpawnDescriptor;
+struct TickContext;
 
 /**
  * @brief Data model for drone telemetry, supports simulation and observer pattern
+ * The model is ticked by DroneSimulator on its worker thread and publishes an
+ * immutable TelemetrySnapshot after every tick for the GUI to read.
  */
 class TelemetryModel : public QObject
 {
@@ -32,13 +49,120 @@ public:
         return _drone;
     }
 
+    /**
+     * @brief Get the fleet storage backing the model's drones
+     */
+    FleetState* getFleet()
+    {
+        return &_fleet;
+    }
+
+    /**
+     * @brief Get the tick-phase profiler (always on; read it from any thread)
+     */
+    TickProfiler* getProfiler()
+    {
+        return &_profiler;
+    }
+
     /**
      * @brief Set the current drone
      */
     void setDrone(Drone* drone);
+
+    /**
+     * @brief Make the drone in a fleet slot the current drone
+     * The current drone is the one shown in detail and targeted by failure
+     * simulation; the failure flag follows the newly selected drone.
+     * @param droneIndex Fleet slot of the drone
+     */
+    void selectDrone(int droneIndex);
+
+    /**
+     * @brief Grow the fleet to the given size with default drones named DRONE-nnn
+     * Despawned drones' names are reused first, oldest first, then new numbers
+     * come from the model's counter; a live drone's name is never taken.
+     * @param droneCount Total number of drones wanted (the fleet never shrinks)
+     */
+    void resizeFleet(int droneCount);
+
+    /**
+     * @brief Spawn a batch of drones into the fleet (see DroneFactory::spawnDrones)
+     * Generated IDs reuse despawned drones' names first, then are numbered from
+     * the model's counter; descriptor.firstNumber is ignored.
+     * @return Number of drones spawned
+     */
+    int spawnDrones(const SpawnDescriptor& descriptor);
+
+    /**
+     * @brief Despawn the drone in a fleet slot
+     * The last drone moves into the freed slot (see FleetState::removeDrone). If
+     * the current drone is removed, the drone now in its slot becomes current.
+     * @param droneIndex Fleet slot of the drone
+     * @return False if the slot is out of range or holds the only drone
+     */
+    bool removeDrone(int droneIndex);
     
+    /**
+     * @brief Find the drones within a horizontal distance of a point (any thread)
+     * Answered from the SpatialIndex built at the last tick.
+     * @return Fleet slots in ascending order
+     */
+    QVector<int> findDronesWithinRadius(double latitude, double longitude, double radiusMetres);
+
+    /**
+     * @brief Find the drones inside a latitude/longitude box (any thread)
+     * @return Fleet slots in ascending order
+     */
+    QVector<int> findDronesInBox(double minLatitude, double minLongitude, double maxLatitude, double maxLongitude);
+
+    /**
+     * @brief Find the drone closest to a point, e.g. to pick the drone under the cursor (any thread)
+     * @return Its fleet slot, or -1 if none is within maxDistanceMetres
+     */
+    int findNearestDrone(double latitude, double longitude, double maxDistanceMetres);
+
+    /**
+     * @brief Set the spatial index cell edge in metres (best close to the usual query radius)
+     */
+    void setSpatialIndexCellSize(double cellSize);
+
+    /**
+     * @brief Set the separation minima in metres (see SeparationMonitor)
+     * The spatial index cell size is raised to the horizontal minimum if it is
+     * smaller, so the check never has to visit more than a few cells per drone.
+     */
+    void setSeparationMinima(double horizontalMetres, double verticalMetres);
+
+    /**
+     * @brief Turn the per-tick separation check on or off (off by default)
+     * Turning it on forgets earlier conflicts, so the conflicts present at the
+     * next tick are all reported as new.
+     */
+    void setSeparationMonitoringEnabled(bool enabled);
+
+    /**
+     * @brief Check if the per-tick separation check is on
+     */
+    bool isSeparationMonitoringEnabled() const
+    {
+        return _separationMonitoringEnabled;
+    }
+
+    /**
+     * @brief Get the conflicts found at the last tick (any thread)
+     */
+    QVector<SeparationConflict> getActiveConflicts() const;
+
+    /**
+     * @brief Get the number of conflicts that started since monitoring was turned on (any thread)
+     */
+    quint64 getSeparationConflictCount() const;
+
     /**
      * @brief Set the current movement strategy
+     * Strategies are not owned; use StrategyFactory's shared instances to
+     * switch strategies without allocating.
      */
     void setMovementStrategy(MovementStrategy* strategy);
 
@@ -49,14 +173,48 @@ public:
     {
         return _currentStrategy;
     }
+
+    /**
+     * @brief Give one drone its own movement strategy instead of the current one
+     * Lets a single fleet mix strategies; nullptr returns the drone to the current strategy.
+     * @param droneIndex Fleet slot of the drone
+     * @param strategy Strategy to use for that drone (not owned)
+     */
+    void setDroneStrategy(int droneIndex, MovementStrategy* strategy);
+
+    /**
+     * @brief Set how many threads run each tick (0 = one per core)
+     */
+    void setThreadCount(int threadCount);
+
+    /**
+     * @brief Get the requested tick thread count (0 = one per core)
+     */
+    int getThreadCount() const
+    {
+        return _threadCount;
+    }
     
     /**
-     * @brief Start the simulation timer
+     * @brief Set the simulation seed; the same seed and fleet replay bit-exactly
+     */
+    void setSeed(quint64 seed);
+
+    /**
+     * @brief Get the simulation seed
+     */
+    quint64 getSeed() const
+    {
+        return _rng.getSeed();
+    }
+    
+    /**
+     * @brief Mark the simulation as running (ticks are driven by DroneSimulator)
      */
     void startSimulation();
 
     /**
-     * @brief Stop the simulation timer
+     * @brief Mark the simulation as stopped
      */
     void stopSimulation();
 
@@ -65,8 +223,53 @@ public:
      */
     bool isSimulationRunning() const
     {
-        return _simulationTimer->isActive();
+        return _simulationRunning;
     }
+
+    /**
+     * @brief Advance the simulation by one tick and publish a snapshot
+     * Called from the simulation thread; safe against concurrent UI commands.
+     * @param dt Simulated seconds covered by the tick
+     */
+    void updateTelemetry(double dt);
+
+    /**
+     * @brief Replace the fleet with a recorded snapshot and publish it as if it were a tick
+     * Used by TelemetryReplay: consumers receive it through the snapshot buffers
+     * and telemetryUpdated like live telemetry. Per-drone strategy assignments
+     * are not recorded and are reset. Stop the simulation before loading.
+     */
+    void loadSnapshot(const TelemetrySnapshot& snapshot);
+
+    /**
+     * @brief Open a snapshot buffer that receives every snapshot published from now on
+     * Each consumer (UI, exporter) opens its own buffer and reads it without
+     * locks; the buffer starts with the current state. Owned by the model.
+     */
+    TelemetrySnapshotBuffer* openSnapshotBuffer();
+
+    /**
+     * @brief Stop publishing to a buffer from openSnapshotBuffer() and delete it
+     */
+    void closeSnapshotBuffer(TelemetrySnapshotBuffer* buffer);
+    
+    /**
+     * @brief Start recording every tick's fleet telemetry to a binary file
+     * Encoding and I/O happen on the recorder's own thread; see TelemetryRecorder.
+     * @param path Recording file (truncated if it exists)
+     * @return False if the file could not be created or a recording is already running
+     */
+    bool startRecording(const QString& path);
+
+    /**
+     * @brief Finish the running recording, if any, and close its file
+     */
+    void stopRecording();
+
+    /**
+     * @brief Check if a recording is running
+     */
+    bool isRecording() const;
     
     /**
      * @brief Toggle failure simulation mode
@@ -83,9 +286,12 @@ public:
     
 signals:
     /**
-     * @brief Emitted when telemetry data is updated
+     * @brief Emitted on the model's thread when new snapshots have been published
+     * Coalesced: while one notification is still queued, further ticks only add
+     * their fields to it, so a busy receiver never works through stale updates.
+     * @param changedFields TelemetryField bits of the fields that changed
      */
-    void telemetryUpdated();
+    void telemetryUpdated(quint32 changedFields);
 
     /**
      * @brief Emitted when simulation starts
@@ -108,27 +314,96 @@ signals:
      */
     void strategyChanged(const QString& strategyName);
 
-private slots:
     /**
-     * @brief Update telemetry data (called by timer)
+     * @brief Emitted when a different drone becomes the current drone
      */
-    void updateTelemetry();
+    void droneChanged(Drone* drone);
 
     /**
-     * @brief Handle drone telemetry updates
+     * @brief Emitted on the simulation thread when drones lose separation
+     * Only conflicts that started this tick are passed; a pair that stays in
+     * conflict is not reported again until it has been separated.
+     * @param conflicts The new conflicts, ordered by fleet slots
+     * @param detectionLatencyNs Time from the tick's new positions to the conflicts being known
+     */
+    void separationConflictsDetected(const QVector<SeparationConflict>& conflicts, qint64 detectionLatencyNs);
+
+private slots:
+    /**
+     * @brief Emit telemetryUpdated for the fields accumulated since the last notification
      */
-    void onDroneTelemetryUpdated();
+    void deliverTelemetryUpdate();
 
 private:
+    FleetState _fleet;                   // Fleet telemetry storage
     Drone* _drone;                       // Current drone
+    DronePool* _dronePool;               // Recycled views for the current drone
     MovementStrategy* _currentStrategy;  // Current movement strategy
-    QTimer* _simulationTimer;            // Simulation timer
+    QVector<MovementStrategy*> _droneStrategies; // Per-drone strategies by FleetState strategy ID (0 = current)
+    int _threadCount;                    // Requested tick threads (0 = one per core)
+    std::unique_ptr<ParallelTickExecutor> _executor; // Tick thread pool, created for multi-chunk fleets
+    bool _simulationRunning;             // Simulation running flag
     bool _failureSimulationActive;       // Failure simulation flag
+    quint64 _tick;                       // Number of ticks simulated
+    double _simulationTime;              // Simulated seconds elapsed
+    CounterRng _rng;                     // Counter-based RNG keyed by the seed
+    int _nextDroneNumber;                // Number of the next new generated drone ID (guarded by _mutex)
+    QVector<DroneId> _freeDroneIds;      // IDs of despawned drones, oldest first, for reuse by spawns (guarded by _mutex)
+    mutable QMutex _mutex;               // Guards drone/strategy against the simulation thread
+    std::vector<std::unique_ptr<TelemetrySnapshotBuffer>> _snapshotBuffers; // Consumer buffers (guarded by _mutex)
+    std::atomic<quint32> _notifyFields;  // Fields awaiting deliverTelemetryUpdate()
+    std::unique_ptr<TelemetryRecorder> _recorder; // Running recording (guarded by _mutex)
+    TickProfiler _profiler;              // Per-phase tick timings
+    SpatialIndex _spatialIndex;          // Proximity index over the fleet, updated every tick (guarded by _mutex)
+    bool _spatialIndexDirty;             // Fleet changed outside a tick; update the index before querying
+    SeparationMonitor _separationMonitor; // Per-tick separation check over the spatial index (guarded by _mutex)
+    bool _separationMonitoringEnabled;   // Run the separation check every tick
+    qint64 _lastConflictReportNs;        // When a separation conflict was last logged
     
     /**
      * @brief Initialize the default movement strategy
      */
     void initializeDefaultStrategy();
+
+    /**
+     * @brief Drain the batteries of every drone in the slice without per-drone signals
+     * @param dt Simulated seconds covered by the tick
+     */
+    static void drainBatteries(const FleetSlice& slice, double dt);
+
+    /**
+     * @brief Advance one chunk of the fleet (runs on a tick worker)
+     * Strategy dispatch is per run of drones sharing a strategy ID; the current
+     * drone's battery is skipped so it can drain through Drone afterwards.
+     * Time spent in strategies and in battery drain is added to times.
+     */
+    void tickChunk(const FleetSlice& chunk, const TickContext& context, int droneIndex, TickPhaseTimes& times) const;
+
+    /**
+     * @brief Bring the spatial index up to date if the fleet changed since the last tick (caller holds _mutex)
+     */
+    void ensureSpatialIndex();
+
+    /**
+     * @brief Get the strategy for a FleetState strategy ID
+     */
+    MovementStrategy* strategyFor(quint8 strategyId) const;
+
+    /**
+     * @brief Publish the current drone's fleet to every snapshot buffer (caller holds _mutex)
+     * @param changedFields TelemetryField bits that changed since the last publish
+     */
+    void publishSnapshot(quint32 changedFields);
+
+    /**
+     * @brief Fill a snapshot (a buffer's back slot, or one to record) from the current drone's fleet
+     */
+    void fillSnapshot(TelemetrySnapshot& snapshot) const;
+
+    /**
+     * @brief Queue a coalesced telemetryUpdated notification (any thread)
+     */
+    void notifyTelemetryUpdated(quint32 changedFields);
 };
 
 #endif // TELEMETRYMODEL_H 
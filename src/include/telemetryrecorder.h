@@ -0,0 +1,184 @@
+#ifndef TELEMETRYRECORDER_H
+#define TELEMETRYRECORDER_H
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include "telemetryrecording.h"
+#include "telemetrysnapshot.h"
+
+class QThread;
+
+/**
+ * @brief Records fleet snapshots to a compact columnar binary file
+ * The simulation thread only pushes each tick's snapshot into a lock-free
+ * queue (the fleet arrays are implicitly shared, so that is a handful of
+ * reference counts); a writer thread quantises, delta-encodes and appends
+ * it to a memory-mapped file. A recorder that falls behind drops frames
+ * rather than stalling the tick. See TelemetryRecording for the format.
+ */
+class TelemetryRecorder
+{
+public:
+    static constexpr int DEFAULT_CHUNK_FRAMES = 64;   // Frames between chunk headers (and keyframes)
+    static constexpr int DEFAULT_QUEUE_CAPACITY = 64; // Snapshots waiting for the writer
+
+    /**
+     * @brief Construct a closed recorder
+     */
+    TelemetryRecorder();
+
+    /**
+     * @brief Destructor; closes the recording
+     */
+    ~TelemetryRecorder();
+
+    TelemetryRecorder(const TelemetryRecorder&) = delete;
+    TelemetryRecorder& operator=(const TelemetryRecorder&) = delete;
+
+    /**
+     * @brief Create the recording file and start the writer thread
+     * @param path File to write (truncated if it exists)
+     * @param chunkFrames Frames per chunk; shorter chunks seek faster, longer ones compress better
+     * @param queueCapacity Snapshots that may wait for the writer (rounded up to a power of two)
+     * @return False if the file could not be created
+     */
+    bool open(const QString& path, int chunkFrames = DEFAULT_CHUNK_FRAMES,
+              int queueCapacity = DEFAULT_QUEUE_CAPACITY);
+
+    /**
+     * @brief Write out queued snapshots, append the chunk index and close the file
+     */
+    void close();
+
+    /**
+     * @brief Check if a recording is open
+     */
+    bool isOpen() const
+    {
+        return _writerThread != nullptr;
+    }
+
+    /**
+     * @brief Queue a snapshot for recording (simulation thread only, never blocks)
+     * @return False if the queue was full and the snapshot was dropped
+     */
+    bool record(const TelemetrySnapshot& snapshot);
+
+    /**
+     * @brief Get the number of frames written so far
+     */
+    quint64 getRecordedFrames() const
+    {
+        return _recordedFrames.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of snapshots dropped because the writer fell behind,
+     * the recording failed, or a drone in them had no ID
+     */
+    quint64 getDroppedFrames() const
+    {
+        return _droppedFrames.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of bytes of recorded chunks so far
+     */
+    quint64 getBytesWritten() const
+    {
+        return _bytesWritten.load(std::memory_order_relaxed);
+    }
+
+private:
+    QFile _file;                          // Recording file
+    TelemetryRecording::FileHeader* _header; // Mapped file header
+    uchar* _window;                       // Mapped region being written
+    quint64 _windowOffset;                // File offset of _window
+    quint64 _windowBytes;                 // Size of _window
+    quint64 _chunkOffset;                 // File offset of the open chunk's header (0 = none open)
+    quint64 _writeOffset;                 // File offset of the next byte to write
+    int _chunkFrames;                     // Frames per chunk
+    QVector<DroneId> _chunkIds;           // Drone ID per slot in the open chunk's first frame
+    QVector<DroneId> _slotIds;            // Drone ID per slot in the previous frame
+    QVector<int> _slotOfId;               // Slot of each DroneId in _slotIds (stale entries do not match it)
+    QVector<TelemetryRecording::SlotChange> _slotChanges; // Slot changes of the frame being written
+    QVector<QByteArray> _newIds;          // UTF-8 IDs of the new drones among _slotChanges
+    QVector<qint32> _previous;            // Previous frame's quantised values, column after column
+    QVector<qint32> _remapped;            // _previous rearranged to the slots of the frame being written
+    QVector<TelemetryRecording::ChunkIndexEntry> _index; // Closed chunks
+    bool _failed;                         // An I/O error stopped the recording
+    bool _warnedInvalidId;                // A frame with an unnamed drone was dropped and logged
+
+    QVector<TelemetrySnapshot> _queue;    // Single-producer/single-consumer ring
+    size_t _queueMask;                    // Ring capacity - 1
+    alignas(64) std::atomic<size_t> _queueHead; // Next slot to fill (simulation thread)
+    alignas(64) std::atomic<size_t> _queueTail; // Next slot to write (writer thread)
+
+    QThread* _writerThread;               // Background writer
+    std::atomic<bool> _stopWriter;        // Asks the writer to drain and exit
+    std::atomic<quint64> _recordedFrames; // Frames written
+    std::atomic<quint64> _droppedFrames;  // Snapshots dropped (full queue, failed recording, unnamed drones)
+    std::atomic<quint64> _bytesWritten;   // Bytes of closed chunks
+
+    /**
+     * @brief Writer thread body: encode queued snapshots until asked to stop
+     */
+    void writerLoop();
+
+    /**
+     * @brief Encode one snapshot as a frame, starting a new chunk when due
+     */
+    void writeFrame(const TelemetrySnapshot& snapshot);
+
+    /**
+     * @brief Start a chunk (keyframe) at the write offset, writing the drone IDs that changed since the chunk before
+     */
+    bool beginChunk(const FleetState& fleet);
+
+    /**
+     * @brief Find the slots whose drone changed since the previous frame and move _previous along
+     * Fills _slotChanges and _newIds, so the frame's deltas stay per drone.
+     * @return Bytes of the frame's slot change block (0 = same drones as the previous frame)
+     */
+    quint64 diffSlots(const FleetState& fleet);
+
+    /**
+     * @brief Write the slot change block found by diffSlots() at out
+     * @return Pointer just past the block
+     */
+    quint8* writeSlotChanges(quint8* out, int droneCount) const;
+
+    /**
+     * @brief Record which drone is in a slot of _slotIds
+     */
+    void setSlotId(int slot, DroneId id);
+
+    /**
+     * @brief Finish the open chunk: record it in the index and publish it in the file header
+     */
+    void endChunk();
+
+    /**
+     * @brief Make sure the mapped window holds the open chunk plus bytes more at the write offset
+     * Remaps from the start of the open chunk so its header stays writable,
+     * growing the file in large steps.
+     */
+    bool reserve(quint64 bytes);
+
+    /**
+     * @brief Get a pointer to the mapped byte at a file offset inside the window
+     */
+    uchar* at(quint64 offset) const
+    {
+        return _window + (offset - _windowOffset);
+    }
+
+    /**
+     * @brief Give up on the recording after an I/O error
+     */
+    void fail(const QString& message);
+};
+
+#endif // TELEMETRYRECORDER_H
@@ -0,0 +1,206 @@
+#ifndef TELEMETRYRECORDING_H
+#define TELEMETRYRECORDING_H
+
+#include <QtGlobal>
+#include <cmath>
+
+/**
+ * @brief On-disk layout of a binary telemetry recording
+ *
+ * A recording is a FileHeader followed by a sequence of chunks and, once the
+ * recorder has closed cleanly, a chunk index:
+ *
+ *   FileHeader
+ *   ChunkHeader, [drone IDs], FrameHeader, [slot changes], columns, FrameHeader, columns, ...
+ *   ChunkHeader, ...
+ *   ChunkIndexEntry[indexCount]
+ *
+ * Each frame holds one tick of the whole fleet as per-field column blocks:
+ * every drone's latitude, then every drone's longitude, and so on. Values are
+ * quantised to integers (fixed-point lat/lon, centimetres, centidegrees) and
+ * stored as zigzag varint deltas against the previous frame. The first frame
+ * of every chunk is a keyframe, delta-coded against zero, so any chunk can be
+ * decoded without reading the ones before it. Chunk and frame headers start
+ * at 8-byte aligned offsets (drone IDs and frame payloads are zero-padded),
+ * and structures are written in host (little-endian) byte order.
+ *
+ * Drones spawning, despawning or moving slots do not end a chunk: the frame
+ * they first show up in starts with a slot change block (see FrameHeader),
+ * which says where each changed slot's drone was in the frame before.
+ */
+namespace TelemetryRecording
+{
+constexpr char FILE_MAGIC[8] = {'D', 'R', 'N', 'T', 'L', 'M', 'R', 'C'}; // FileHeader::magic
+constexpr quint32 FORMAT_VERSION = 2;
+constexpr quint32 MIN_FORMAT_VERSION = 1; // Oldest version readers accept (no slot change blocks)
+constexpr quint32 CHUNK_MAGIC = 0x4B4E4843; // "CHNK"
+
+constexpr double DEGREE_SCALE = 1e7;   // Lat/lon fixed point: 1e-7 degree (~1 cm)
+constexpr double METRE_SCALE = 100.0;  // Altitude and speed in centimetres
+constexpr double HEADING_SCALE = 100.0; // Heading in centidegrees
+
+/**
+ * @brief Column order within a frame
+ */
+enum Column
+{
+    LATITUDE_COLUMN,
+    LONGITUDE_COLUMN,
+    ALTITUDE_COLUMN,
+    HEADING_COLUMN,
+    SPEED_COLUMN,
+    BATTERY_COLUMN,
+    GPS_FIX_COLUMN,
+    FAILURE_MODE_COLUMN,
+    COLUMN_COUNT
+};
+
+constexpr int MAX_VARINT_BYTES = 5; // A delta of two qint32 values, zigzagged, fits in 5 bytes
+constexpr quint64 HEADER_ALIGNMENT = 8; // Alignment of chunk and frame headers
+constexpr quint32 NEW_DRONE = 0xFFFFFFFF; // SlotChange::source of a drone not in the frame before
+
+/**
+ * @brief Start of the file
+ */
+struct FileHeader
+{
+    char magic[8];          // FILE_MAGIC
+    quint32 version;        // FORMAT_VERSION
+    quint32 headerBytes;    // sizeof(FileHeader)
+    qint64 createdMs;       // Wall-clock creation time (ms since epoch)
+    quint64 dataEnd;        // End of the last complete chunk, updated as chunks close
+    quint64 indexOffset;    // Offset of the chunk index (0 = recording not closed cleanly)
+    quint64 indexCount;     // Number of ChunkIndexEntry records
+};
+
+/**
+ * @brief Start of a chunk; followed by the chunk's new drone IDs, then its frames
+ * The drone IDs of the first frame are those of the chunk before (at its
+ * first frame) up to slot droneCount - newIdCount, followed by the newIdCount
+ * IDs stored here, each as a quint16 byte length and UTF-8 bytes. Only the
+ * slots that differ from the chunk before are written, so a chunk whose
+ * newIdCount equals droneCount carries every ID.
+ */
+struct ChunkHeader
+{
+    quint32 magic;              // CHUNK_MAGIC
+    quint32 frameCount;         // Frames in the chunk
+    quint32 droneCount;         // Drones in the first frame of the chunk
+    quint32 newIdCount;         // Drone IDs introduced by this chunk
+    quint64 chunkBytes;         // Bytes from this header to the next one
+    quint64 firstTick;          // Tick of the first frame
+    quint64 lastTick;           // Tick of the last frame
+    double firstSimulationTime; // Simulated seconds at the first frame
+    double lastSimulationTime;  // Simulated seconds at the last frame
+};
+
+/**
+ * @brief Start of a frame; followed by its slot changes, if any, then COLUMN_COUNT column blocks of varints
+ * A frame whose drones differ from the frame before starts with a
+ * SlotChangeHeader, its SlotChange entries, and the quint16-length UTF-8 ID
+ * of each entry whose source is NEW_DRONE. Slots without an entry keep their
+ * drone. The columns of a changed slot are deltas against its drone's values
+ * in the frame before (against zero for a new drone).
+ */
+struct FrameHeader
+{
+    quint64 tick;            // Simulation tick
+    double simulationTime;   // Simulated seconds elapsed
+    qint64 timestampMs;      // Wall-clock publication time (ms since epoch)
+    quint32 payloadBytes;    // Bytes of slot changes and column data following the header, including padding
+    quint32 slotChangeBytes; // Bytes of slot changes at the start of the payload (0 = same drones)
+};
+
+/**
+ * @brief Start of a frame's slot changes
+ */
+struct SlotChangeHeader
+{
+    quint32 droneCount;     // Drones in the frame
+    quint32 changeCount;    // SlotChange entries that follow
+};
+
+/**
+ * @brief A slot holding a different drone than in the frame before
+ */
+struct SlotChange
+{
+    quint32 slot;           // Slot in this frame
+    quint32 source;         // Slot of the drone in the frame before, or NEW_DRONE
+};
+
+/**
+ * @brief One entry of the chunk index, sorted by time
+ */
+struct ChunkIndexEntry
+{
+    quint64 offset;             // File offset of the ChunkHeader
+    quint64 firstTick;          // Tick of the first frame
+    double firstSimulationTime; // Simulated seconds at the first frame
+    double lastSimulationTime;  // Simulated seconds at the last frame
+    quint32 frameCount;         // Frames in the chunk
+    quint32 droneCount;         // Drones in the first frame
+};
+
+static_assert(sizeof(FileHeader) == 48, "FileHeader layout changed");
+static_assert(sizeof(ChunkHeader) == 56, "ChunkHeader layout changed");
+static_assert(sizeof(FrameHeader) == 32, "FrameHeader layout changed");
+static_assert(sizeof(SlotChangeHeader) == 8, "SlotChangeHeader layout changed");
+static_assert(sizeof(SlotChange) == 8, "SlotChange layout changed");
+static_assert(sizeof(ChunkIndexEntry) == 40, "ChunkIndexEntry layout changed");
+
+/**
+ * @brief Round a file offset up to the next header position
+ */
+inline quint64 alignOffset(quint64 offset)
+{
+    return (offset + HEADER_ALIGNMENT - 1) & ~(HEADER_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Quantise a value to the integer stored in a column
+ */
+inline qint32 quantize(double value, double scale)
+{
+    return static_cast<qint32>(std::llround(value * scale));
+}
+
+/**
+ * @brief Append the zigzag varint of (value - previous) at out
+ * @return Pointer just past the written bytes
+ */
+inline quint8* writeDelta(quint8* out, qint32 value, qint32 previous)
+{
+    qint64 delta = static_cast<qint64>(value) - previous;
+    quint64 zigzag = (static_cast<quint64>(delta) << 1) ^ static_cast<quint64>(delta >> 63);
+    while (zigzag >= 0x80)
+    {
+        *out++ = static_cast<quint8>(zigzag | 0x80);
+        zigzag >>= 7;
+    }
+    *out++ = static_cast<quint8>(zigzag);
+    return out;
+}
+
+/**
+ * @brief Read one zigzag varint delta written by writeDelta()
+ * @return Pointer just past the varint, or nullptr if it runs past end or is too long
+ */
+inline const quint8* readDelta(const quint8* in, const quint8* end, qint64& delta)
+{
+    quint64 zigzag = 0;
+    for (int shift = 0; in < end && shift < 7 * MAX_VARINT_BYTES; shift += 7)
+    {
+        quint8 byte = *in++;
+        zigzag |= static_cast<quint64>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            delta = static_cast<qint64>(zigzag >> 1) ^ -static_cast<qint64>(zigzag & 1);
+            return in;
+        }
+    }
+    return nullptr;
+}
+}
+
+#endif // TELEMETRYRECORDING_H
@@ -0,0 +1,184 @@
+#ifndef TELEMETRYRECORDINGREADER_H
+#define TELEMETRYRECORDINGREADER_H
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <cstring>
+#include "fleetstate.h"
+#include "telemetryrecording.h"
+#include "telemetrysnapshot.h"
+
+/**
+ * @brief Random access to the frames of a telemetry recording
+ * The whole file is memory-mapped and only its small chunk index is copied
+ * out, so opening and seeking a multi-gigabyte recording touch only the
+ * pages they read. Frames are numbered from 0 across the recording. Decoding is
+ * incremental: stepping forwards applies the next frame's deltas, stepping
+ * backwards subtracts the current one's, and only a jump to another chunk
+ * (or back over a frame where drones changed slots) restarts from a keyframe.
+ * Drone IDs are resolved per chunk and per frame, so every frame shows the
+ * drones that were in its slots when it was recorded. See TelemetryRecording
+ * for the format.
+ */
+class TelemetryRecordingReader
+{
+public:
+    /**
+     * @brief Construct a closed reader
+     */
+    TelemetryRecordingReader();
+
+    /**
+     * @brief Destructor; unmaps the recording
+     */
+    ~TelemetryRecordingReader();
+
+    TelemetryRecordingReader(const TelemetryRecordingReader&) = delete;
+    TelemetryRecordingReader& operator=(const TelemetryRecordingReader&) = delete;
+
+    /**
+     * @brief Map a recording and load its chunk index
+     * A recording that was not closed cleanly has no index; its chunk
+     * headers are walked instead (one hop per chunk, not a scan of the data).
+     * @return False if the file cannot be mapped or is not a recording; see getErrorString()
+     */
+    bool open(const QString& path);
+
+    /**
+     * @brief Unmap the recording
+     */
+    void close();
+
+    /**
+     * @brief Check if a recording is open
+     */
+    bool isOpen() const
+    {
+        return _data != nullptr;
+    }
+
+    /**
+     * @brief Get the reason the last open() failed
+     */
+    QString getErrorString() const
+    {
+        return _errorString;
+    }
+
+    /**
+     * @brief Get the number of frames in the recording
+     */
+    quint64 getFrameCount() const
+    {
+        return _frameCount;
+    }
+
+    /**
+     * @brief Get the simulated time of the first frame
+     */
+    double getStartTime() const;
+
+    /**
+     * @brief Get the simulated time of the last frame
+     */
+    double getEndTime() const;
+
+    /**
+     * @brief Find the last frame at or before a simulated time (the first frame if before the start)
+     * Binary search over the chunk index, then a hop over at most one chunk's frame headers.
+     */
+    quint64 findFrame(double simulationTime) const;
+
+    /**
+     * @brief Decode a frame into a snapshot
+     * @return False if the frame does not exist or its data is corrupt
+     */
+    bool readFrame(quint64 frame, TelemetrySnapshot& snapshot);
+
+private:
+    QFile _file;                        // Recording file
+    const uchar* _data;                 // Mapped file
+    quint64 _size;                      // Mapped bytes
+    QVector<TelemetryRecording::ChunkIndexEntry> _chunks; // Chunk index, sorted by time
+    QVector<quint64> _firstFrames;      // Number of the first frame of each chunk
+    quint64 _frameCount;                // Frames in the recording
+    QVector<int> _idBases;              // Per chunk: latest chunk at or before it that carries every drone ID
+    QString _errorString;               // Reason open() failed
+
+    int _idsChunk;                      // Chunk whose first frame _chunkIds belong to (-1 = none)
+    QVector<DroneId> _chunkIds;         // Drone ID per slot at the first frame of _idsChunk (INVALID_DRONE_ID = not recorded)
+    int _baseChunk;                     // Chunk _baseIds belong to (-1 = none)
+    QVector<DroneId> _baseIds;          // Drone IDs of the last chunk carrying all of them, to seek back to cheaply
+    QVector<DroneId> _slotIds;          // Drone ID per slot of _frame
+    bool _slotIdsChanged;               // _slotIds differ from the IDs in _fleet
+
+    int _chunk;                         // Chunk being decoded (-1 = none)
+    int _frame;                         // Frame within _chunk that _values hold (-1 = none)
+    int _droneCount;                    // Drones per frame in _chunk
+    QVector<quint64> _frameOffsets;     // File offset of each FrameHeader in _chunk
+    QVector<quint32> _frameSlotChanges; // Slot change bytes of each frame in _chunk
+    QVector<qint32> _values;            // Quantised values of _frame, column after column
+    QVector<qint32> _remapped;          // _values rearranged by a frame's slot changes
+    FleetState _fleet;                  // Decoded fleet, shared with the snapshots handed out
+
+    /**
+     * @brief Copy a structure out of the mapping (offsets are not aligned)
+     */
+    template <typename T>
+    T readStruct(quint64 offset) const
+    {
+        T value;
+        std::memcpy(&value, _data + offset, sizeof(T));
+        return value;
+    }
+
+    /**
+     * @brief Find the chunk index: use the one in the file, or rebuild it from chunk headers
+     */
+    bool loadIndex();
+
+    /**
+     * @brief Find, for each chunk, the chunk its drone IDs build on
+     */
+    bool loadIdBases();
+
+    /**
+     * @brief Resolve the drone IDs of a chunk's first frame into _chunkIds
+     */
+    bool loadChunkIds(int chunk);
+
+    /**
+     * @brief Intern count length-prefixed UTF-8 drone IDs and append them to ids
+     * @return Pointer just past the IDs, or nullptr if they run past end
+     */
+    const quint8* readIds(const quint8* in, const quint8* end, quint32 count, QVector<DroneId>& ids) const;
+
+    /**
+     * @brief Get the file offset of a chunk's first frame, past its drone IDs (0 if corrupt)
+     */
+    quint64 framesOffset(const TelemetryRecording::ChunkIndexEntry& entry) const;
+
+    /**
+     * @brief Start decoding a chunk: locate its frames and reset to the keyframe base
+     */
+    bool enterChunk(int chunk);
+
+    /**
+     * @brief Go back to the base of _chunk's keyframe (zero values, the chunk's drone IDs)
+     */
+    void restartChunk();
+
+    /**
+     * @brief Add (direction 1) or subtract (direction -1) a frame's deltas to _values
+     * Frames with slot changes are only applied forwards.
+     */
+    bool applyFrame(int frame, int direction);
+
+    /**
+     * @brief Move _values and _slotIds to the slots of a frame's slot change block
+     */
+    bool applySlotChanges(const quint8* in, quint32 bytes);
+};
+
+#endif // TELEMETRYRECORDINGREADER_H
@@ -0,0 +1,155 @@
+#ifndef TELEMETRYREPLAY_H
+#define TELEMETRYREPLAY_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QString>
+#include "telemetryrecordingreader.h"
+
+class TelemetryModel;
+class QTimer;
+
+/**
+ * @brief Plays a telemetry recording back through a TelemetryModel
+ * Each frame shown is loaded into the model with TelemetryModel::loadSnapshot(),
+ * so it reaches the snapshot buffers and telemetryUpdated exactly like a live
+ * tick and the UI needs no replay-specific path. Playback runs on a wall-clock
+ * timer at any speed, backwards for negative speeds, and seek() jumps
+ * anywhere in the recording through its chunk index. The live simulation
+ * should be stopped while a recording is open.
+ */
+class TelemetryReplay : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int PLAYBACK_INTERVAL_MS = 16; // Playback clock (~60 frames shown per second)
+    static constexpr double MAX_SPEED = 1000.0;     // Fastest playback, in either direction
+
+    /**
+     * @brief Construct a replay feeding the given model
+     * @param model Model the frames are loaded into (not owned)
+     * @param parent The parent QObject
+     */
+    explicit TelemetryReplay(TelemetryModel* model, QObject* parent = nullptr);
+
+    /**
+     * @brief Open a recording and show its first frame
+     * @return False if the file is not a readable recording; see getErrorString()
+     */
+    bool open(const QString& path);
+
+    /**
+     * @brief Stop playback and close the recording
+     */
+    void close();
+
+    /**
+     * @brief Check if a recording is open
+     */
+    bool isOpen() const
+    {
+        return _reader.isOpen();
+    }
+
+    /**
+     * @brief Get the reason the last open() failed
+     */
+    QString getErrorString() const
+    {
+        return _errorString;
+    }
+
+    /**
+     * @brief Get the simulated time of the first recorded frame
+     */
+    double getStartTime() const
+    {
+        return _reader.getStartTime();
+    }
+
+    /**
+     * @brief Get the simulated time of the last recorded frame
+     */
+    double getEndTime() const
+    {
+        return _reader.getEndTime();
+    }
+
+    /**
+     * @brief Get the playback position in simulated seconds
+     */
+    double getPosition() const
+    {
+        return _position;
+    }
+
+    /**
+     * @brief Set the playback speed as a multiple of real time
+     * @param speed Negative values play backwards; clamped to [-MAX_SPEED, MAX_SPEED]
+     */
+    void setSpeed(double speed);
+
+    /**
+     * @brief Get the playback speed (negative = backwards)
+     */
+    double getSpeed() const
+    {
+        return _speed;
+    }
+
+    /**
+     * @brief Start playing from the current position
+     */
+    void play();
+
+    /**
+     * @brief Pause playback on the current frame
+     */
+    void pause();
+
+    /**
+     * @brief Check if playback is running
+     */
+    bool isPlaying() const;
+
+    /**
+     * @brief Jump to a simulated time and show the frame recorded at or before it
+     * Works while playing or paused, so it can follow a scrub slider directly.
+     */
+    void seek(double simulationTime);
+
+signals:
+    /**
+     * @brief Emitted when the playback position moves
+     */
+    void positionChanged(double simulationTime);
+
+    /**
+     * @brief Emitted when playback starts or stops, including at either end of the recording
+     */
+    void playingChanged(bool playing);
+
+private slots:
+    /**
+     * @brief Playback clock tick: advance the position by the elapsed wall time
+     */
+    void onPlaybackTimeout();
+
+private:
+    TelemetryModel* _model;             // Model the frames are loaded into
+    TelemetryRecordingReader _reader;   // Open recording
+    QTimer* _playbackTimer;             // Playback clock
+    QElapsedTimer _wallClock;           // Wall time since the last playback tick
+    double _position;                   // Playback position (simulated seconds)
+    double _speed;                      // Playback speed (negative = backwards)
+    qint64 _shownFrame;                 // Frame last loaded into the model (-1 = none)
+    QString _errorString;               // Reason open() failed
+
+    /**
+     * @brief Load the frame at the playback position into the model, if it is not shown already
+     */
+    void showPosition();
+};
+
+#endif // TELEMETRYREPLAY_H
@@ -0,0 +1,22 @@
+#ifndef TELEMETRYSNAPSHOT_H
+#define TELEMETRYSNAPSHOT_H
+
+#include <QtGlobal>
+#include "fleetstate.h"
+
+/**
+ * @brief Copy of the fleet telemetry taken at the end of a simulation tick
+ * Produced on the simulation thread and handed to consumers through a
+ * TelemetrySnapshotBuffer; a consumer reads it without touching the live
+ * fleet that the simulation keeps mutating. The fleet arrays are implicitly
+ * shared, so taking a snapshot does not copy them until the next tick writes.
+ */
+struct TelemetrySnapshot
+{
+    quint64 tick = 0;            // Simulation tick that produced the snapshot
+    double simulationTime = 0.0; // Simulated seconds elapsed at publication
+    qint64 timestampMs = 0;      // Wall-clock time of publication (ms since epoch)
+    FleetState fleet;            // Copy of the fleet telemetry
+};
+
+#endif // TELEMETRYSNAPSHOT_H
@@ -0,0 +1,83 @@
+#ifndef TELEMETRYSNAPSHOTBUFFER_H
+#define TELEMETRYSNAPSHOTBUFFER_H
+
+#include <QtGlobal>
+#include <atomic>
+#include "telemetrysnapshot.h"
+
+/**
+ * @brief Lock-free triple buffer handing telemetry snapshots from the simulation to one consumer
+ * The producer fills the back slot and swaps it with the middle slot; the
+ * consumer swaps the middle slot with its front slot when a newer snapshot is
+ * there. Neither side ever blocks, and a consumer that falls behind simply
+ * picks up the latest snapshot, skipping the ones it missed.
+ */
+class TelemetrySnapshotBuffer
+{
+public:
+    /**
+     * @brief Construct a buffer with three empty snapshots
+     */
+    TelemetrySnapshotBuffer();
+
+    TelemetrySnapshotBuffer(const TelemetrySnapshotBuffer&) = delete;
+    TelemetrySnapshotBuffer& operator=(const TelemetrySnapshotBuffer&) = delete;
+
+    /**
+     * @brief Get the slot to fill with the next snapshot (producer only)
+     */
+    TelemetrySnapshot& beginWrite()
+    {
+        return _slots[_back];
+    }
+
+    /**
+     * @brief Publish the slot filled since beginWrite() (producer only)
+     * @param changedFields TelemetryField bits that changed since the last publish
+     */
+    void publish(quint32 changedFields);
+
+    /**
+     * @brief Take the TelemetryField bits published since the last call (consumer only)
+     * Call before acquireLatest() so no published change is ever missed.
+     */
+    quint32 takeChangedFields()
+    {
+        return _changedFields.exchange(0, std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Switch current() to the newest published snapshot (consumer only)
+     * @return True if a snapshot newer than the previous current() was available
+     */
+    bool acquireLatest();
+
+    /**
+     * @brief Get the snapshot acquired last; stable until the next acquireLatest() (consumer only)
+     */
+    const TelemetrySnapshot& current() const
+    {
+        return _slots[_front];
+    }
+
+    /**
+     * @brief Get the number of snapshots overwritten before the consumer acquired them
+     */
+    quint64 getSkippedCount() const
+    {
+        return _skippedCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr quint32 INDEX_MASK = 0x3; // Slot index bits of _middle
+    static constexpr quint32 FRESH_FLAG = 0x4; // Set while _middle holds an unread snapshot
+
+    TelemetrySnapshot _slots[3];                 // Back, middle and front snapshots
+    int _back;                                   // Slot the producer writes (producer only)
+    int _front;                                  // Slot the consumer reads (consumer only)
+    alignas(64) std::atomic<quint32> _middle;    // Slot in the middle, plus FRESH_FLAG
+    alignas(64) std::atomic<quint32> _changedFields; // Fields published but not yet taken
+    std::atomic<quint64> _skippedCount;          // Snapshots the consumer never saw
+};
+
+#endif // TELEMETRYSNAPSHOTBUFFER_H
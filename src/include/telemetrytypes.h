@@ -0,0 +1,43 @@
+#ifndef TELEMETRYTYPES_H
+#define TELEMETRYTYPES_H
+
+#include <QtGlobal>
+
+/**
+ * @brief Enum for GPS fix status
+ */
+enum class GPSFixStatus : quint8
+{
+    NO_FIX,   // No GPS fix
+    FIX_2D,   // 2D GPS fix
+    FIX_3D    // 3D GPS fix
+};
+
+/**
+ * @brief Compact drone identifier used in fleet storage, snapshots and events
+ * DroneNameTable maps it to the display name ("DRONE-001").
+ */
+typedef quint32 DroneId;
+
+/**
+ * @brief Bit flags identifying which telemetry fields changed in a notification
+ */
+namespace TelemetryField
+{
+enum : quint32
+{
+    NONE      = 0,
+    LATITUDE  = 1u << 0,
+    LONGITUDE = 1u << 1,
+    ALTITUDE  = 1u << 2,
+    HEADING   = 1u << 3,
+    SPEED     = 1u << 4,
+    BATTERY   = 1u << 5,
+    GPS_FIX   = 1u << 6,
+    POSITION  = LATITUDE | LONGITUDE | ALTITUDE,
+    KINEMATICS = POSITION | HEADING | SPEED, // Fields written by movement strategies
+    ALL       = KINEMATICS | BATTERY | GPS_FIX
+};
+}
+
+#endif // TELEMETRYTYPES_H
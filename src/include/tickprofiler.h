@@ -0,0 +1,159 @@
+#ifndef TICKPROFILER_H
+#define TICKPROFILER_H
+
+#include <QString>
+#include <atomic>
+#include "latencyhistogram.h"
+#include "tracerecorder.h"
+
+/**
+ * @brief Per-tick totals of phases that run concurrently on the tick workers
+ */
+struct TickPhaseTimes
+{
+    std::atomic<qint64> strategyNs{0}; // Strategy updates, summed over chunks
+    std::atomic<qint64> batteryNs{0};  // Battery drain, summed over chunks
+};
+
+/**
+ * @brief Always-on profiler that splits simulation ticks into phases
+ * Each phase has its own LatencyHistogram, fed by TelemetryModel,
+ * DroneSimulator and the UI with a monotonic timestamp before and after the
+ * phase, so profiling costs a clock read and a few atomic adds per phase and
+ * stays enabled in production. Phases timed with lap() are also recorded as
+ * TraceRecorder events. Ticks longer than the tick budget (the wall time one
+ * step may take at the current time scale) are counted as overruns.
+ */
+class TickProfiler
+{
+public:
+    /**
+     * @brief Profiled phases, in the order they appear in reports
+     */
+    enum Phase
+    {
+        TICK_PHASE,         // Whole TelemetryModel::updateTelemetry()
+        FLEET_UPDATE_PHASE, // Parallel strategy and battery pass (wall time)
+        STRATEGY_PHASE,     // Strategy updates (CPU time summed over workers)
+        BATTERY_PHASE,      // Battery drain (CPU time summed over workers)
+        SPATIAL_INDEX_PHASE, // SpatialIndex update over the new positions (wall time)
+        CONFLICT_DETECTION_PHASE, // New positions to separation conflicts known, spatial index included (detection latency)
+        PUBLISH_PHASE,      // Snapshot publication to every consumer buffer
+        RECORD_PHASE,       // Handing the snapshot to the recorder
+        SIGNAL_PHASE,       // Current drone's signal fan-out
+        WAKE_UP_PHASE,      // One DroneSimulator wake-up with all its due ticks
+        LOGGING_PHASE,      // Log calls made from the simulation loop
+        UI_REFRESH_PHASE,   // One MainWindow display refresh
+        PHASE_COUNT
+    };
+
+    static constexpr qint64 OVERRUN_REPORT_INTERVAL_NS = 10000000000ll; // Least time between overrun reports
+
+    TickProfiler();
+
+    TickProfiler(const TickProfiler&) = delete;
+    TickProfiler& operator=(const TickProfiler&) = delete;
+
+    /**
+     * @brief Get the display name of a phase
+     */
+    static const char* phaseName(Phase phase);
+
+    /**
+     * @brief Get the monotonic clock in nanoseconds (any thread); the same clock as trace events
+     */
+    qint64 now() const
+    {
+        return TraceRecorder::now();
+    }
+
+    /**
+     * @brief Record a phase duration in nanoseconds (any thread)
+     */
+    void record(Phase phase, qint64 durationNs)
+    {
+        _histograms[phase].record(durationNs);
+    }
+
+    /**
+     * @brief Record a phase that started at startNs and ended now, and trace it
+     * @return The end time, to start the next phase from
+     */
+    qint64 lap(Phase phase, qint64 startNs)
+    {
+        qint64 endNs = now();
+        _histograms[phase].record(endNs - startNs);
+        TraceRecorder::getInstance().addEvent(phaseName(phase), phase == UI_REFRESH_PHASE ? "ui" : "simulation",
+                                              startNs, endNs);
+        return endNs;
+    }
+
+    /**
+     * @brief Record a whole tick and check it against the tick budget
+     * @return True if the tick overran and no overrun has been reported for OVERRUN_REPORT_INTERVAL_NS
+     */
+    bool recordTick(qint64 durationNs);
+
+    /**
+     * @brief Get the histogram of a phase
+     */
+    const LatencyHistogram& getHistogram(Phase phase) const
+    {
+        return _histograms[phase];
+    }
+
+    /**
+     * @brief Set the wall time one tick may take (0 = no budget, e.g. when running as fast as possible)
+     */
+    void setTickBudget(qint64 budgetNs);
+
+    /**
+     * @brief Get the tick budget in nanoseconds (0 = none)
+     */
+    qint64 getTickBudget() const
+    {
+        return _tickBudgetNs.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of ticks that took longer than the budget
+     */
+    quint64 getOverrunCount() const
+    {
+        return _overrunCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the longest tick that overran, in nanoseconds
+     */
+    qint64 getWorstOverrun() const
+    {
+        return _worstOverrunNs.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Clear every histogram and the overrun count
+     */
+    void reset();
+
+    /**
+     * @brief Format a table of every phase's count, mean, p50, p99, p999 and max
+     */
+    QString formatReport() const;
+
+    /**
+     * @brief Write formatReport() to a text file
+     * @return False if the file could not be written
+     */
+    bool writeReport(const QString& path) const;
+
+private:
+    LatencyHistogram _histograms[PHASE_COUNT];     // Duration histogram per phase
+    std::atomic<qint64> _tickBudgetNs;             // Wall time a tick may take (0 = none)
+    std::atomic<quint64> _overrunCount;            // Ticks over budget
+    std::atomic<qint64> _worstOverrunNs;           // Longest tick over budget
+    std::atomic<qint64> _lastOverrunReportNs;      // When recordTick() last asked for a report
+    std::atomic<qint64> _resetNs;                  // When the histograms were last cleared
+};
+
+#endif // TICKPROFILER_H
@@ -0,0 +1,190 @@
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+/**
+ * @brief Singleton flight recorder for Chrome/Perfetto trace events
+ * Every thread appends complete ("X") events to its own fixed-size ring, so
+ * recording is a clock read and a few stores with no lock and no allocation;
+ * old events are overwritten. Nothing is formatted until writeTrace() is
+ * asked for the last few seconds, which makes it cheap enough to leave on and
+ * capture a window around a hiccup after the fact. Names, categories and
+ * argument names must be string literals (only the pointers are stored).
+ * A thread's ring is handed back when the thread exits and taken over by the
+ * next new thread, so threads that come and go do not pile up rings.
+ */
+class TraceRecorder
+{
+public:
+    static constexpr int EVENTS_PER_THREAD = 1 << 15;             // Ring capacity per thread (1.5 MB)
+    static constexpr qint64 DEFAULT_WINDOW_NS = 10000000000ll;    // Default span written by writeTrace()
+
+    /**
+     * @brief One timed interval on one thread
+     */
+    struct TraceEvent
+    {
+        const char* name;     // Event name (literal)
+        const char* category; // Trace category (literal)
+        const char* argName;  // Name of the optional argument (literal, nullptr = none)
+        qint64 argValue;      // Optional argument value
+        qint64 startNs;       // Start on the now() clock
+        qint64 durationNs;    // Duration in nanoseconds
+    };
+
+    /**
+     * @brief Get the singleton instance
+     */
+    static TraceRecorder& getInstance();
+
+    /**
+     * @brief Get the process-wide monotonic clock in nanoseconds, shared with TickProfiler
+     */
+    static qint64 now();
+
+    /**
+     * @brief Turn recording on or off (on by default)
+     */
+    void setEnabled(bool enabled)
+    {
+        _enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Check if events are being recorded
+     */
+    bool isEnabled() const
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Record an interval on the calling thread's ring
+     */
+    void addEvent(const char* name, const char* category, qint64 startNs, qint64 endNs,
+                  const char* argName = nullptr, qint64 argValue = 0)
+    {
+        if (isEnabled())
+        {
+            threadRing()->push({name, category, argName, argValue, startNs, endNs - startNs});
+        }
+    }
+
+    /**
+     * @brief Write the events of the last windowNs nanoseconds as Chrome trace JSON
+     * Open the file in Perfetto (ui.perfetto.dev) or chrome://tracing.
+     * @return False if the file could not be written
+     */
+    bool writeTrace(const QString& path, qint64 windowNs = DEFAULT_WINDOW_NS);
+
+    /**
+     * @brief Discard every recorded event
+     */
+    void clear();
+
+private:
+    /**
+     * @brief Single-producer ring of one thread's events
+     * Only the owning thread writes; readers copy the slots and then drop any
+     * the producer may have overwritten meanwhile.
+     */
+    struct TraceRing
+    {
+        QString threadName;              // Shown as the track name in the viewer
+        int threadId = 0;                // Trace "tid"
+        TraceEvent events[EVENTS_PER_THREAD]; // Slots, indexed by position % EVENTS_PER_THREAD
+        std::atomic<quint64> written{0}; // Events ever pushed
+        std::atomic<quint64> cleared{0}; // Position of the last clear()
+        std::atomic<bool> inUse{true};   // Owned by a running thread
+
+        void push(const TraceEvent& event)
+        {
+            quint64 position = written.load(std::memory_order_relaxed);
+            events[position % EVENTS_PER_THREAD] = event;
+            written.store(position + 1, std::memory_order_release);
+        }
+    };
+
+    /**
+     * @brief A thread's claim on its ring, released when the thread exits
+     */
+    struct RingLease
+    {
+        TraceRing* ring = nullptr; // Ring of the owning thread (nullptr = none yet)
+
+        ~RingLease()
+        {
+            if (ring)
+            {
+                ring->inUse.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    TraceRecorder();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    /**
+     * @brief Get (creating on first use) the calling thread's ring
+     */
+    TraceRing* threadRing();
+
+    /**
+     * @brief Copy a ring's surviving events that ended at or after sinceNs
+     */
+    static void collectEvents(const TraceRing& ring, qint64 sinceNs, QVector<TraceEvent>& events);
+
+    std::atomic<bool> _enabled; // Recording flag
+    QMutex _mutex;              // Guards the ring registry
+    QVector<TraceRing*> _rings; // Per-thread rings; an exited thread's events stay until a new thread takes its ring
+    int _nextThreadId;          // Trace "tid" of the next thread to get a ring (guarded by _mutex)
+};
+
+/**
+ * @brief Records the lifetime of a scope as a trace event
+ */
+class TraceScope
+{
+public:
+    TraceScope(const char* name, const char* category, const char* argName = nullptr, qint64 argValue = 0)
+        : _name(name)
+        , _category(category)
+        , _argName(argName)
+        , _argValue(argValue)
+        , _startNs(TraceRecorder::getInstance().isEnabled() ? TraceRecorder::now() : -1)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (_startNs >= 0)
+        {
+            TraceRecorder::getInstance().addEvent(_name, _category, _startNs, TraceRecorder::now(),
+                                                  _argName, _argValue);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* _name;     // Event name
+    const char* _category; // Trace category
+    const char* _argName;  // Optional argument name
+    qint64 _argValue;      // Optional argument value
+    qint64 _startNs;       // Start time (-1 = tracing was off)
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+// Trace the rest of the enclosing scope: TRACE_SCOPE("Tick", "simulation");
+#define TRACE_SCOPE(...) TraceScope TRACE_CONCAT(traceScope, __LINE__)(__VA_ARGS__)
+
+#endif // TRACERECORDER_H
@@ -0,0 +1,195 @@
+#include "kinematics.h"
+#include <cmath>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define KINEMATICS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+constexpr double FULL_TURN = 360.0;
+constexpr double INV_FULL_TURN = 1.0 / 360.0;
+
+// ---------------------------------------------------------------------------
+// Scalar kernels (portable fallback, written to auto-vectorize)
+// ---------------------------------------------------------------------------
+
+void addScaledScalar(double* values, const double* samples, int count, double offset, double scale)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        values[i] += (samples[i] - offset) * scale;
+    }
+}
+
+void setScaledScalar(double* values, const double* samples, int count, double offset, double scale)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        values[i] = (samples[i] - offset) * scale;
+    }
+}
+
+inline double wrapHeading(double heading)
+{
+    double wrapped = heading - FULL_TURN * std::floor(heading * INV_FULL_TURN);
+    // Tiny negative inputs round up to exactly 360; fold them back without a branch
+    return wrapped - FULL_TURN * static_cast<double>(wrapped >= FULL_TURN);
+}
+
+void wrapHeadingsScalar(double* headings, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        headings[i] = wrapHeading(headings[i]);
+    }
+}
+
+#ifdef KINEMATICS_X86
+// ---------------------------------------------------------------------------
+// SSE4.1 kernels (2 doubles per lane)
+// ---------------------------------------------------------------------------
+
+__attribute__((target("sse4.1")))
+void addScaledSse41(double* values, const double* samples, int count, double offset, double scale)
+{
+    const __m128d vOffset = _mm_set1_pd(offset);
+    const __m128d vScale = _mm_set1_pd(scale);
+    int i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128d delta = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(samples + i), vOffset), vScale);
+        _mm_storeu_pd(values + i, _mm_add_pd(_mm_loadu_pd(values + i), delta));
+    }
+    addScaledScalar(values + i, samples + i, count - i, offset, scale);
+}
+
+__attribute__((target("sse4.1")))
+void setScaledSse41(double* values, const double* samples, int count, double offset, double scale)
+{
+    const __m128d vOffset = _mm_set1_pd(offset);
+    const __m128d vScale = _mm_set1_pd(scale);
+    int i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        _mm_storeu_pd(values + i, _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(samples + i), vOffset), vScale));
+    }
+    setScaledScalar(values + i, samples + i, count - i, offset, scale);
+}
+
+__attribute__((target("sse4.1")))
+void wrapHeadingsSse41(double* headings, int count)
+{
+    const __m128d vTurn = _mm_set1_pd(FULL_TURN);
+    const __m128d vInvTurn = _mm_set1_pd(INV_FULL_TURN);
+    int i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128d h = _mm_loadu_pd(headings + i);
+        __m128d turns = _mm_floor_pd(_mm_mul_pd(h, vInvTurn));
+        __m128d wrapped = _mm_sub_pd(h, _mm_mul_pd(turns, vTurn));
+        __m128d overflow = _mm_and_pd(_mm_cmpge_pd(wrapped, vTurn), vTurn);
+        _mm_storeu_pd(headings + i, _mm_sub_pd(wrapped, overflow));
+    }
+    wrapHeadingsScalar(headings + i, count - i);
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 kernels (4 doubles per lane)
+// ---------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+void addScaledAvx2(double* values, const double* samples, int count, double offset, double scale)
+{
+    const __m256d vOffset = _mm256_set1_pd(offset);
+    const __m256d vScale = _mm256_set1_pd(scale);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256d delta = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(samples + i), vOffset), vScale);
+        _mm256_storeu_pd(values + i, _mm256_add_pd(_mm256_loadu_pd(values + i), delta));
+    }
+    addScaledScalar(values + i, samples + i, count - i, offset, scale);
+}
+
+__attribute__((target("avx2")))
+void setScaledAvx2(double* values, const double* samples, int count, double offset, double scale)
+{
+    const __m256d vOffset = _mm256_set1_pd(offset);
+    const __m256d vScale = _mm256_set1_pd(scale);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm256_storeu_pd(values + i, _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(samples + i), vOffset), vScale));
+    }
+    setScaledScalar(values + i, samples + i, count - i, offset, scale);
+}
+
+__attribute__((target("avx2")))
+void wrapHeadingsAvx2(double* headings, int count)
+{
+    const __m256d vTurn = _mm256_set1_pd(FULL_TURN);
+    const __m256d vInvTurn = _mm256_set1_pd(INV_FULL_TURN);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256d h = _mm256_loadu_pd(headings + i);
+        __m256d turns = _mm256_floor_pd(_mm256_mul_pd(h, vInvTurn));
+        __m256d wrapped = _mm256_sub_pd(h, _mm256_mul_pd(turns, vTurn));
+        __m256d overflow = _mm256_and_pd(_mm256_cmp_pd(wrapped, vTurn, _CMP_GE_OQ), vTurn);
+        _mm256_storeu_pd(headings + i, _mm256_sub_pd(wrapped, overflow));
+    }
+    wrapHeadingsScalar(headings + i, count - i);
+}
+#endif // KINEMATICS_X86
+
+const KinematicsKernels SCALAR_KERNELS = { "scalar", addScaledScalar, setScaledScalar, wrapHeadingsScalar };
+#ifdef KINEMATICS_X86
+const KinematicsKernels SSE41_KERNELS = { "sse4.1", addScaledSse41, setScaledSse41, wrapHeadingsSse41 };
+const KinematicsKernels AVX2_KERNELS = { "avx2", addScaledAvx2, setScaledAvx2, wrapHeadingsAvx2 };
+#endif
+}
+
+namespace Kinematics
+{
+Isa bestSupportedIsa()
+{
+#ifdef KINEMATICS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return Isa::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1"))
+    {
+        return Isa::SSE41;
+    }
+#endif
+    return Isa::Scalar;
+}
+
+const KinematicsKernels& kernels()
+{
+    static const KinematicsKernels& selected = kernels(bestSupportedIsa());
+    return selected;
+}
+
+const KinematicsKernels& kernels(Isa isa)
+{
+#ifdef KINEMATICS_X86
+    Isa best = bestSupportedIsa();
+    if (isa == Isa::AVX2 && best == Isa::AVX2)
+    {
+        return AVX2_KERNELS;
+    }
+    if (isa == Isa::SSE41 && best != Isa::Scalar)
+    {
+        return SSE41_KERNELS;
+    }
+#else
+    (void)isa;
+#endif
+    return SCALAR_KERNELS;
+}
+}
@@ -0,0 +1,111 @@
+#include "latencyhistogram.h"
+#include <cmath>
+
+namespace
+{
+/**
+ * @brief Rank (1-based) of the value at a percentile of total values
+ */
+quint64 percentileRank(double percentile, quint64 total)
+{
+    double rank = std::ceil(qBound(0.0, percentile, 100.0) / 100.0 * static_cast<double>(total));
+    return qBound<quint64>(1, static_cast<quint64>(rank), total);
+}
+}
+
+LatencyHistogram::LatencyHistogram()
+    : _count(0)
+    , _total(0)
+    , _max(0)
+{
+    for (std::atomic<quint64>& count : _counts)
+    {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (std::atomic<quint64>& count : _counts)
+    {
+        count.store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _total.store(0, std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+}
+
+qint64 LatencyHistogram::getValueAtPercentile(double percentile) const
+{
+    quint64 total = 0;
+    for (const std::atomic<quint64>& count : _counts)
+    {
+        total += count.load(std::memory_order_relaxed);
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    quint64 rank = percentileRank(percentile, total);
+    quint64 seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += _counts[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            return qMin(bucketUpperBound(i), getMax());
+        }
+    }
+    return getMax();
+}
+
+LatencyHistogram::Summary LatencyHistogram::getSummary() const
+{
+    // Work from one copy so the percentiles agree with each other while records keep arriving
+    quint64 counts[BUCKET_COUNT];
+    quint64 total = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i)
+    {
+        counts[i] = _counts[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    Summary summary;
+    summary.count = total;
+    summary.max = getMax();
+    if (total == 0)
+    {
+        return summary;
+    }
+    summary.mean = static_cast<double>(_total.load(std::memory_order_relaxed)) /
+                   qMax<quint64>(getCount(), 1);
+
+    const double percentiles[] = {50.0, 99.0, 99.9};
+    qint64* values[] = {&summary.p50, &summary.p99, &summary.p999};
+    int next = 0;
+    quint64 seen = 0;
+    for (int i = 0; i < BUCKET_COUNT && next < 3; ++i)
+    {
+        seen += counts[i];
+        while (next < 3 && seen >= percentileRank(percentiles[next], total))
+        {
+            *values[next++] = qMin(bucketUpperBound(i), summary.max);
+        }
+    }
+    return summary;
+}
+
+qint64 LatencyHistogram::bucketUpperBound(int index)
+{
+    if (index < SUB_BUCKET_COUNT)
+    {
+        return index;
+    }
+
+    // Inverse of bucketIndex(): the magnitude picks the width, the rest the offset
+    constexpr int halfCount = SUB_BUCKET_COUNT / 2;
+    int shift = index / halfCount - 1;
+    qint64 lowerBound = static_cast<qint64>(index - shift * halfCount) << shift;
+    return lowerBound + (1ll << shift) - 1;
+}
@@ -2,11 +2,105 @@
 #include <QDir>
 #include <QCoreApplication>
 #include <QDateTime>
+#include <QThread>
 #include <QDebug>
+#include <algorithm>
+
+namespace
+{
+constexpr unsigned long WRITER_POLL_MS = 5; // Writer sleep when all rings are empty
+}
+
+/**
+ * @brief Compact log record: the caller only captures the time, level and message
+ */
+struct Logger::LogRecord
+{
+    qint64 timestampMs = 0;
+    LogLevel level = DEBUG;
+    QString message;
+};
+
+/**
+ * @brief Single-producer/single-consumer ring of log records
+ * The owning thread pushes, the writer thread pops; head and tail are the
+ * only shared state and live on separate cache lines.
+ */
+struct Logger::LogRing
+{
+    explicit LogRing(int capacity)
+    {
+        size_t size = 1;
+        while (size < static_cast<size_t>(qMax(capacity, 2)))
+        {
+            size <<= 1;
+        }
+        records.resize(static_cast<int>(size));
+        mask = size - 1;
+    }
+
+    bool tryPush(LogRecord& record)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) > mask)
+        {
+            return false;
+        }
+        records[static_cast<int>(h & mask)] = std::move(record);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(LogRecord& record)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        record = std::move(records[static_cast<int>(t & mask)]);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    QVector<LogRecord> records;
+    size_t mask = 0;
+    std::atomic<bool> inUse{true};           // Owned by a running producer thread
+    alignas(64) std::atomic<size_t> head{0}; // Next slot to write (producer)
+    std::atomic<bool> pushing{false};        // The producer is inside enqueue() (read by disableAsync)
+    alignas(64) std::atomic<size_t> tail{0}; // Next slot to read (writer)
+};
+
+/**
+ * @brief A producer thread's claim on its ring, released when the thread exits
+ * The writer still drains whatever the thread left behind; the next new
+ * thread takes the ring over and keeps pushing after it.
+ */
+struct Logger::RingLease
+{
+    ~RingLease()
+    {
+        if (ring)
+        {
+            ring->inUse.store(false, std::memory_order_release);
+        }
+    }
+
+    LogRing* ring = nullptr;
+};
 
 Logger* Logger::_instance = nullptr;
+std::atomic<int> Logger::_minimumLevel(Logger::DEBUG);
 
-Logger::Logger(QObject* parent) : QObject(parent)
+Logger::Logger(QObject* parent)
+    : QObject(parent)
+    , _overflowPolicy(DROP)
+    , _writerThread(nullptr)
+    , _asyncEnabled(false)
+    , _stopWriter(false)
+    , _droppedCount(0)
+    , _reportedDropCount(0)
+    , _lastFlushMs(0)
 {
     try
     {
@@ -50,6 +144,9 @@ Logger::Logger(QObject* parent) : QObject(parent)
 
 Logger::~Logger()
 {
+    disableAsync();
+    qDeleteAll(_rings);
+    
     if (_logFile.isOpen())
     {
         _logFile.close();
@@ -82,20 +179,25 @@ Logger& Logger::getInstance()
 
 void Logger::log(LogLevel level, const QString& message)
 {
+    if (!isLevelEnabled(level))
+    {
+        return;
+    }
+    
     try
     {
+        if (isAsync() && enqueue(level, message))
+        {
+            return;
+        }
+        
         QMutexLocker locker(&_mutex);
-        QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
-        QString logMessage = QString("[%1] [%2] %3")
-                            .arg(timestamp)
-                            .arg(levelToString(level))
-                            .arg(message);
+        QString logMessage = formatMessage(QDateTime::currentMSecsSinceEpoch(), level, message);
+        writeLine(logMessage, true);
         if (_logFile.isOpen())
         {
-            _logStream << logMessage << Qt::endl;
             _logStream.flush();
         }
-        qDebug().noquote() << logMessage;
     }
     catch (const std::exception& e)
     {
@@ -107,6 +209,212 @@ void Logger::log(LogLevel level, const QString& message)
     }
 }
 
+void Logger::enableAsync()
+{
+    enableAsync(AsyncOptions());
+}
+
+void Logger::enableAsync(const AsyncOptions& options)
+{
+    if (isAsync())
+    {
+        disableAsync();
+    }
+    
+    {
+        QMutexLocker locker(&_mutex);
+        _asyncOptions = options;
+        _overflowPolicy.store(options.overflowPolicy, std::memory_order_relaxed);
+        _lastFlushMs = QDateTime::currentMSecsSinceEpoch();
+    }
+    
+    _stopWriter.store(false, std::memory_order_release);
+    _writerThread = QThread::create([this]() { writerLoop(); });
+    _writerThread->setObjectName("LogWriterThread");
+    _writerThread->start();
+    _asyncEnabled.store(true, std::memory_order_release);
+    
+    log(INFO, QString("Async logging enabled (ring capacity %1, flush interval %2 ms, overflow policy %3)")
+              .arg(options.ringCapacity)
+              .arg(options.flushIntervalMs)
+              .arg(options.overflowPolicy == BLOCK ? "block" : "drop"));
+}
+
+void Logger::disableAsync()
+{
+    if (!_writerThread)
+    {
+        return;
+    }
+    
+    _asyncEnabled.store(false, std::memory_order_seq_cst);
+    _stopWriter.store(true, std::memory_order_release);
+    _writerThread->wait();
+    delete _writerThread;
+    _writerThread = nullptr;
+    
+    // A producer that saw async mode still on may be mid-push; wait for it so the
+    // drain below writes its record (later producers see the mode off and write directly)
+    QVector<LogRing*> rings;
+    {
+        QMutexLocker locker(&_mutex);
+        rings = _rings;
+    }
+    for (LogRing* ring : rings)
+    {
+        while (ring->pushing.load(std::memory_order_acquire))
+        {
+            QThread::yieldCurrentThread();
+        }
+    }
+    
+    // Records pushed after the writer's final drain are written here
+    QVector<LogRecord> batch;
+    drainRings(batch);
+    writeBatch(batch, true);
+}
+
+bool Logger::enqueue(LogLevel level, const QString& message)
+{
+    LogRing* ring = threadRing();
+    
+    // Announce the push before checking the mode; disableAsync() clears the mode before
+    // waiting for announced pushes, so either it drains this record or we write it directly
+    ring->pushing.store(true, std::memory_order_seq_cst);
+    if (!_asyncEnabled.load(std::memory_order_seq_cst))
+    {
+        ring->pushing.store(false, std::memory_order_release);
+        return false;
+    }
+    
+    LogRecord record;
+    record.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    record.level = level;
+    record.message = message;
+    
+    bool queued = true;
+    while (!ring->tryPush(record))
+    {
+        if (_overflowPolicy.load(std::memory_order_relaxed) == DROP)
+        {
+            _droppedCount.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        if (!isAsync())
+        {
+            queued = false;
+            break;
+        }
+        QThread::yieldCurrentThread();
+    }
+    ring->pushing.store(false, std::memory_order_release);
+    return queued;
+}
+
+Logger::LogRing* Logger::threadRing()
+{
+    thread_local RingLease lease;
+    if (!lease.ring)
+    {
+        // Rings are owned by the logger; take over one whose thread has exited before adding one
+        QMutexLocker locker(&_mutex);
+        for (LogRing* ring : _rings)
+        {
+            if (!ring->inUse.load(std::memory_order_acquire))
+            {
+                ring->inUse.store(true, std::memory_order_relaxed);
+                lease.ring = ring;
+                break;
+            }
+        }
+        if (!lease.ring)
+        {
+            lease.ring = new LogRing(_asyncOptions.ringCapacity);
+            _rings.append(lease.ring);
+        }
+    }
+    return lease.ring;
+}
+
+bool Logger::drainRings(QVector<LogRecord>& batch)
+{
+    QVector<LogRing*> rings;
+    {
+        QMutexLocker locker(&_mutex);
+        rings = _rings;
+    }
+    
+    bool urgent = false;
+    LogRecord record;
+    for (LogRing* ring : rings)
+    {
+        while (ring->tryPop(record))
+        {
+            urgent = urgent || record.level >= _asyncOptions.flushLevel;
+            batch.append(std::move(record));
+        }
+    }
+    
+    // Each ring is already ordered; merge threads by time
+    std::stable_sort(batch.begin(), batch.end(), [](const LogRecord& a, const LogRecord& b) {
+        return a.timestampMs < b.timestampMs;
+    });
+    return urgent;
+}
+
+void Logger::writeBatch(QVector<LogRecord>& batch, bool forceFlush)
+{
+    QMutexLocker locker(&_mutex);
+    
+    quint64 dropped = _droppedCount.load(std::memory_order_relaxed);
+    if (dropped != _reportedDropCount)
+    {
+        writeLine(formatMessage(QDateTime::currentMSecsSinceEpoch(), WARNING,
+                                QString("Logger dropped %1 records (ring buffer full)")
+                                .arg(dropped - _reportedDropCount)),
+                  _asyncOptions.echoToConsole);
+        _reportedDropCount = dropped;
+    }
+    
+    for (const LogRecord& record : batch)
+    {
+        writeLine(formatMessage(record.timestampMs, record.level, record.message),
+                  _asyncOptions.echoToConsole);
+    }
+    batch.clear();
+    
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (forceFlush || now - _lastFlushMs >= _asyncOptions.flushIntervalMs)
+    {
+        if (_logFile.isOpen())
+        {
+            _logStream.flush();
+        }
+        _lastFlushMs = now;
+    }
+}
+
+void Logger::writerLoop()
+{
+    QVector<LogRecord> batch;
+    
+    while (!_stopWriter.load(std::memory_order_acquire))
+    {
+        bool urgent = drainRings(batch);
+        if (batch.isEmpty())
+        {
+            // Still honour the flush interval for records written earlier
+            writeBatch(batch, false);
+            QThread::msleep(WRITER_POLL_MS);
+            continue;
+        }
+        writeBatch(batch, urgent);
+    }
+    
+    drainRings(batch);
+    writeBatch(batch, true);
+}
+
 void Logger::debug(const QString& message)
 {
     log(DEBUG, message);
@@ -127,6 +435,27 @@ void Logger::error(const QString& message)
     log(ERROR, message);
 }
 
+QString Logger::formatMessage(qint64 timestampMs, LogLevel level, const QString& message)
+{
+    QString timestamp = QDateTime::fromMSecsSinceEpoch(timestampMs).toString("yyyy-MM-dd hh:mm:ss.zzz");
+    return QString("[%1] [%2] %3")
+           .arg(timestamp)
+           .arg(levelToString(level))
+           .arg(message);
+}
+
+void Logger::writeLine(const QString& line, bool echoToConsole)
+{
+    if (_logFile.isOpen())
+    {
+        _logStream << line << '\n';
+    }
+    if (echoToConsole)
+    {
+        qDebug().noquote() << line;
+    }
+}
+
 QString Logger::levelToString(LogLevel level)
 {
     switch (level)
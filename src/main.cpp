@@ -1,5 +1,6 @@
 #include "mainwindow.h"
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QStyleFactory>
 #include <QDir>
 #include <QMessageBox>
@@ -20,10 +21,24 @@ int main(int argc, char *argv[])
         // Set modern style
         app.setStyle(QStyleFactory::create("Fusion"));
 
+        QCommandLineParser parser;
+        parser.setApplicationDescription("Simulates real-time drone telemetry.");
+        parser.addHelpOption();
+        parser.addVersionOption();
+        QCommandLineOption refreshRateOption("refresh-rate", "Display refresh rate in Hz (e.g. 30 or 60).", "hz",
+                                             QString::number(MainWindow::DEFAULT_REFRESH_RATE_HZ));
+        QCommandLineOption dronesOption("drones", "Number of drones in the fleet.", "count", "1");
+        QCommandLineOption replayOption("replay", "Open a telemetry recording for replay.", "file");
+        parser.addOption(refreshRateOption);
+        parser.addOption(dronesOption);
+        parser.addOption(replayOption);
+        parser.process(app);
+
         qDebug() << "Application initialized successfully";
         try
         {
-            Logger::getInstance();
+            // Format and write log records on a background thread, off the UI and simulation threads
+            Logger::getInstance().enableAsync();
             qDebug() << "Logger initialized successfully";
         }
         catch (const std::exception& e)
@@ -35,10 +50,30 @@ int main(int argc, char *argv[])
         
         // Create and show main window
         MainWindow window;
+        bool refreshRateOk = false;
+        int refreshRate = parser.value(refreshRateOption).toInt(&refreshRateOk);
+        if (refreshRateOk && refreshRate > 0)
+        {
+            window.setRefreshRate(refreshRate);
+        }
+        else
+        {
+            qWarning() << "Ignoring invalid refresh rate:" << parser.value(refreshRateOption);
+        }
+        int droneCount = parser.value(dronesOption).toInt();
+        if (droneCount > 1)
+        {
+            window.setFleetSize(droneCount);
+        }
         window.show();
+        if (parser.isSet(replayOption))
+        {
+            window.openRecording(parser.value(replayOption));
+        }
         qDebug() << "Main window displayed successfully";
         int result = app.exec();
         qDebug() << "Application shutting down";
+        Logger::getInstance().disableAsync();
         return result;
     }
     catch (const std::exception& e)
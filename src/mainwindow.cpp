@@ -2,10 +2,19 @@
 #include "ui_mainwindow.h"
 #include "telemetrymodel.h"
 #include "dronesimulator.h"
-#include "hoverstrategy.h"
-#include "randomwalkstrategy.h"
+#include "strategyfactory.h"
 #include "drone.h"
+#include "fleettablemodel.h"
+#include "telemetryreplay.h"
+#include "profilerpanel.h"
+#include "tracerecorder.h"
 #include "logger.h"
+#include <QHeaderView>
+#include <QDir>
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QSignalBlocker>
 #include <QMessageBox>
 #include <QApplication>
 #include <QDebug>
@@ -15,14 +24,24 @@ MainWindow::MainWindow(QWidget *parent)
     , ui(new Ui::MainWindow)
     , _telemetryModel(nullptr)
     , _simulator(nullptr)
+    , _snapshotBuffer(nullptr)
+    , _fleetTableModel(nullptr)
+    , _replay(nullptr)
+    , _profilerPanel(nullptr)
+    , _refreshTimer(nullptr)
+    , _refreshRateHz(DEFAULT_REFRESH_RATE_HZ)
+    , _batteryBand(-1)
+    , _gpsFixStatus(-1)
 {
     try
     {
         qDebug() << "Setting up UI...";
         ui->setupUi(this);
+        initializeDisplayPalettes();
         
         qDebug() << "Creating telemetry model...";
         _telemetryModel = new TelemetryModel(this);
+        _snapshotBuffer = _telemetryModel->openSnapshotBuffer();
         
         qDebug() << "Creating drone simulator...";
         _simulator = new DroneSimulator(this);
@@ -30,14 +49,25 @@ MainWindow::MainWindow(QWidget *parent)
         qDebug() << "Setting up simulator with telemetry model...";
         _simulator->setTelemetryModel(_telemetryModel);
         
+        _replay = new TelemetryReplay(_telemetryModel, this);
+        
+        qDebug() << "Setting up fleet table...";
+        setupFleetTable();
+        
         qDebug() << "Setting up observer pattern connections...";
         setupConnections();
         
         qDebug() << "Initializing display...";
 
-        updateTelemetryDisplay();
+        refreshFromSnapshot(TelemetryField::ALL);
         setStatusMessage("Ready");
         
+        // Repaint on our own clock rather than on every simulation tick
+        _refreshTimer = new QTimer(this);
+        connect(_refreshTimer, &QTimer::timeout, this, &MainWindow::onRefreshTimeout);
+        setRefreshRate(_refreshRateHz);
+        _refreshTimer->start();
+        
         qDebug() << "MainWindow initialized successfully";
         
     }
@@ -60,9 +90,8 @@ MainWindow::~MainWindow()
 
 void MainWindow::setupConnections()
 {
-    // Observer pattern: Connect model signals to UI update slots
-    connect(_telemetryModel, &TelemetryModel::telemetryUpdated,
-            this, &MainWindow::onTelemetryUpdated);
+    // Observer pattern: Connect model signals to UI update slots; telemetry
+    // itself is pulled from the snapshot buffer by the refresh clock
     connect(_telemetryModel, &TelemetryModel::simulationStarted,
             this, &MainWindow::onSimulationStarted);
     connect(_telemetryModel, &TelemetryModel::simulationStopped,
@@ -71,6 +100,8 @@ void MainWindow::setupConnections()
             this, &MainWindow::onFailureSimulationToggled);
     connect(_telemetryModel, &TelemetryModel::strategyChanged,
             this, &MainWindow::onStrategyChanged);
+    connect(_telemetryModel, &TelemetryModel::droneChanged,
+            this, &MainWindow::onDroneChanged);
     
     // Connect UI controls
     connect(ui->startStopButton, &QPushButton::clicked, 
@@ -79,24 +110,125 @@ void MainWindow::setupConnections()
             this, &MainWindow::onFailureButtonClicked);
     connect(ui->strategyComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), 
             this, &MainWindow::onStrategyComboBoxChanged);
+    connect(ui->gpsFilterComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &MainWindow::onGpsFilterComboBoxChanged);
     
-    // Connect drone signals
-    if (_telemetryModel->getDrone())
-    {
-        connect(_telemetryModel->getDrone(), &Drone::batteryLow,
-                this, &MainWindow::onBatteryLow);
-        connect(_telemetryModel->getDrone(), &Drone::gpsFixLost,
-                this, &MainWindow::onGpsFixLost);
-    }
+    // Connect fleet table selection
+    connect(ui->fleetTableView->selectionModel(), &QItemSelectionModel::currentRowChanged,
+            this, &MainWindow::onFleetRowChanged);
+    connect(_fleetTableModel, &QAbstractItemModel::modelReset,
+            this, &MainWindow::selectCurrentDroneRow);
+    
+    connectDroneSignals(_telemetryModel->getDrone());
+    
+    // Connect replay controls
+    connect(_replay, &TelemetryReplay::positionChanged,
+            this, &MainWindow::onReplayPositionChanged);
+    connect(_replay, &TelemetryReplay::playingChanged,
+            this, &MainWindow::onReplayPlayingChanged);
+    connect(ui->replayPlayButton, &QPushButton::clicked, this, &MainWindow::onReplayPlayButtonClicked);
+    connect(ui->replaySpeedComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &MainWindow::onReplaySpeedComboBoxChanged);
+    connect(ui->replaySlider, &QSlider::valueChanged, this, &MainWindow::onReplaySliderChanged);
     
     // Connect menu actions
+    connect(ui->actionOpenRecording, &QAction::triggered, this, &MainWindow::onActionOpenRecording);
+    connect(ui->actionCloseRecording, &QAction::triggered, this, &MainWindow::onActionCloseRecording);
+    connect(ui->actionTickProfiler, &QAction::triggered, this, &MainWindow::onActionTickProfiler);
+    connect(ui->actionSaveTrace, &QAction::triggered, this, &MainWindow::onActionSaveTrace);
     connect(ui->actionExit, &QAction::triggered, this, &MainWindow::onActionExit);
     connect(ui->actionAbout, &QAction::triggered, this, &MainWindow::onActionAbout);
 }
 
-void MainWindow::onTelemetryUpdated()
+void MainWindow::setRefreshRate(int hz)
+{
+    _refreshRateHz = qBound(1, hz, MAX_REFRESH_RATE_HZ);
+    if (_refreshTimer)
+    {
+        _refreshTimer->setInterval(1000 / _refreshRateHz);
+    }
+    LOG_INFO(QString("Display refresh rate set to %1 Hz").arg(_refreshRateHz));
+}
+
+void MainWindow::setFleetSize(int droneCount)
+{
+    _telemetryModel->resizeFleet(droneCount);
+}
+
+bool MainWindow::openRecording(const QString& path)
+{
+    // Recorded frames replace the live fleet, so the simulation must not tick over them
+    _simulator->stopSimulation();
+    
+    if (!_replay->open(path))
+    {
+        showWarningMessage(QString("Failed to open recording %1: %2").arg(path, _replay->getErrorString()));
+        return false;
+    }
+    
+    onReplaySpeedComboBoxChanged(ui->replaySpeedComboBox->currentIndex());
+    setReplayMode(true);
+    setStatusMessage(QString("Replaying %1").arg(QFileInfo(path).fileName()), "#17A2B8");
+    return true;
+}
+
+void MainWindow::closeRecording()
 {
-    updateTelemetryDisplay();
+    if (_replay->isOpen())
+    {
+        _replay->close();
+        setReplayMode(false);
+        setStatusMessage("Replay closed; showing the last replayed frame", "#6C757D");
+    }
+}
+
+void MainWindow::onRefreshTimeout()
+{
+    refreshFromSnapshot(TelemetryField::NONE);
+}
+
+void MainWindow::onDroneChanged(Drone* drone)
+{
+    connectDroneSignals(drone);
+    selectCurrentDroneRow();
+    refreshFromSnapshot(TelemetryField::ALL);
+}
+
+void MainWindow::onGpsFilterComboBoxChanged(int index)
+{
+    // Combo box order: All, 3D Fix, 2D Fix, No Fix
+    static const int filters[] = {
+        FleetTableModel::NO_GPS_FILTER,
+        static_cast<int>(GPSFixStatus::FIX_3D),
+        static_cast<int>(GPSFixStatus::FIX_2D),
+        static_cast<int>(GPSFixStatus::NO_FIX)
+    };
+    if (index >= 0 && index < static_cast<int>(sizeof(filters) / sizeof(filters[0])))
+    {
+        _fleetTableModel->setGpsFixFilter(filters[index]);
+    }
+}
+
+void MainWindow::onFleetRowChanged(const QModelIndex& current, const QModelIndex& previous)
+{
+    Q_UNUSED(previous);
+    
+    if (current.isValid())
+    {
+        _telemetryModel->selectDrone(_fleetTableModel->slotForRow(current.row()));
+    }
+}
+
+void MainWindow::selectCurrentDroneRow()
+{
+    Drone* drone = _telemetryModel->getDrone();
+    int row = drone ? _fleetTableModel->rowForSlot(drone->getIndex()) : -1;
+    if (row >= 0)
+    {
+        ui->fleetTableView->selectionModel()->setCurrentIndex(
+            _fleetTableModel->index(row, FleetTableModel::ID_COLUMN),
+            QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+    }
 }
 
 void MainWindow::onSimulationStarted()
@@ -155,25 +287,15 @@ void MainWindow::onFailureButtonClicked()
 
 void MainWindow::onStrategyComboBoxChanged(int index)
 {
-    MovementStrategy* newStrategy = nullptr;
-    
-    switch (index)
-    {
-    case 0: // Hover
-        newStrategy = new HoverStrategy(this);
-        break;
-    case 1: // Random Walk
-        newStrategy = new RandomWalkStrategy(this);
-        break;
-    default:
+    // Combo box entries follow StrategyFactory::StrategyType; the instances are shared, not allocated per change
+    MovementStrategy* newStrategy = StrategyFactory::getSharedStrategy(static_cast<StrategyFactory::StrategyType>(index));
+    if (!newStrategy)
+    {
         LOG_WARNING("Unknown strategy index selected");
         return;
     }
     
-    if (newStrategy)
-    {
-        _telemetryModel->setMovementStrategy(newStrategy);
-    }
+    _telemetryModel->setMovementStrategy(newStrategy);
 }
 
 void MainWindow::onBatteryLow(int battery)
@@ -190,6 +312,109 @@ void MainWindow::onGpsFixLost()
     setStatusMessage("GPS Fix Lost", "#DC3545");
 }
 
+void MainWindow::onActionOpenRecording()
+{
+    QString path = QFileDialog::getOpenFileName(this, "Open Telemetry Recording", QString(),
+                                                "Telemetry recordings (*.dtr);;All files (*)");
+    if (!path.isEmpty())
+    {
+        openRecording(path);
+    }
+}
+
+void MainWindow::onActionCloseRecording()
+{
+    closeRecording();
+}
+
+void MainWindow::onReplayPlayButtonClicked()
+{
+    if (_replay->isPlaying())
+    {
+        _replay->pause();
+    }
+    else
+    {
+        _replay->play();
+    }
+}
+
+void MainWindow::onReplaySpeedComboBoxChanged(int index)
+{
+    // Items read like "-2x"
+    QString text = ui->replaySpeedComboBox->itemText(index);
+    bool ok = false;
+    double speed = text.left(text.size() - 1).toDouble(&ok);
+    if (ok)
+    {
+        _replay->setSpeed(speed);
+    }
+}
+
+void MainWindow::onReplaySliderChanged(int value)
+{
+    double span = _replay->getEndTime() - _replay->getStartTime();
+    _replay->seek(_replay->getStartTime() + span * value / REPLAY_SLIDER_STEPS);
+}
+
+void MainWindow::onReplayPositionChanged(double simulationTime)
+{
+    double span = _replay->getEndTime() - _replay->getStartTime();
+    int value = span > 0.0 ? qRound((simulationTime - _replay->getStartTime()) / span * REPLAY_SLIDER_STEPS) : 0;
+    if (ui->replaySlider->value() != value)
+    {
+        // Following playback must not feed back into a seek
+        QSignalBlocker blocker(ui->replaySlider);
+        ui->replaySlider->setValue(value);
+    }
+    setLabelText(ui->replayTimeLabel, QString("%1 s").arg(simulationTime, 0, 'f', 1));
+}
+
+void MainWindow::onReplayPlayingChanged(bool playing)
+{
+    ui->replayPlayButton->setText(playing ? "Pause" : "Play");
+}
+
+void MainWindow::onActionTickProfiler()
+{
+    if (!_profilerPanel)
+    {
+        _profilerPanel = new ProfilerPanel(_telemetryModel->getProfiler(), this);
+    }
+    _profilerPanel->show();
+    _profilerPanel->raise();
+    _profilerPanel->activateWindow();
+}
+
+void MainWindow::onActionSaveTrace()
+{
+    // Take the window now, before the dialog; the rings keep recording while it is open
+    QString tempPath = QDir::temp().filePath(QString("dronetrace-%1.json").arg(QCoreApplication::applicationPid()));
+    if (!TraceRecorder::getInstance().writeTrace(tempPath))
+    {
+        showWarningMessage("Failed to capture the trace");
+        return;
+    }
+    
+    QString path = QFileDialog::getSaveFileName(this, "Save Trace", "trace.json",
+                                                "Chrome trace files (*.json);;All files (*)");
+    if (path.isEmpty())
+    {
+        QFile::remove(tempPath);
+        return;
+    }
+    
+    QFile::remove(path);
+    bool saved = QFile::copy(tempPath, path);
+    QFile::remove(tempPath);
+    if (!saved)
+    {
+        showWarningMessage(QString("Failed to save the trace to %1").arg(path));
+        return;
+    }
+    setStatusMessage(QString("Trace saved to %1").arg(QFileInfo(path).fileName()), "#17A2B8");
+}
+
 void MainWindow::onActionExit()
 {
     QApplication::quit();
@@ -209,76 +434,195 @@ void MainWindow::onActionAbout()
                       "Assignment Built for BoltLab Dynamics");
 }
 
-void MainWindow::updateTelemetryDisplay()
+void MainWindow::setupFleetTable()
 {
-    if (!_telemetryModel->getDrone())
+    _fleetTableModel = new FleetTableModel(this);
+    
+    QTableView* view = ui->fleetTableView;
+    view->setModel(_fleetTableModel);
+    
+    // Fixed row heights keep scrolling O(1) however many drones there are
+    view->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    view->horizontalHeader()->setStretchLastSection(true);
+    view->sortByColumn(FleetTableModel::ID_COLUMN, Qt::AscendingOrder);
+}
+
+void MainWindow::setReplayMode(bool replaying)
+{
+    ui->replayGroupBox->setVisible(replaying);
+    ui->actionCloseRecording->setEnabled(replaying);
+    ui->startStopButton->setEnabled(!replaying);
+    ui->failureButton->setEnabled(!replaying);
+    ui->strategyComboBox->setEnabled(!replaying);
+}
+
+void MainWindow::connectDroneSignals(Drone* drone)
+{
+    // Queued so the modal warning never runs inside a tick
+    if (drone)
     {
-        return;
+        connect(drone, &Drone::batteryLow,
+                this, &MainWindow::onBatteryLow, Qt::QueuedConnection);
+        connect(drone, &Drone::gpsFixLost,
+                this, &MainWindow::onGpsFixLost, Qt::QueuedConnection);
     }
+}
+
+void MainWindow::refreshFromSnapshot(quint32 changedFields)
+{
+    // Read the newest published snapshot, never the drone the simulation thread is
+    // mutating; snapshots published while we were busy are skipped, but their
+    // changed fields are still applied
+    TickProfiler* profiler = _telemetryModel->getProfiler();
+    qint64 refreshStart = profiler->now();
     
-    Drone* drone = _telemetryModel->getDrone();
+    changedFields |= _snapshotBuffer->takeChangedFields();
+    if (_snapshotBuffer->acquireLatest() || changedFields == TelemetryField::ALL)
+    {
+        updateFleetTable();
+    }
+    updateTelemetryDisplay(changedFields);
     
-    // Update telemetry labels
-    ui->droneIdLabel->setText(drone->getId());
-    ui->latitudeLabel->setText(QString::number(drone->getLatitude(), 'f', 6));
-    ui->longitudeLabel->setText(QString::number(drone->getLongitude(), 'f', 6));
-    ui->altitudeLabel->setText(QString("%1 m").arg(drone->getAltitude(), 0, 'f', 1));
-    ui->headingLabel->setText(QString("%1°").arg(drone->getHeading(), 0, 'f', 1));
-    ui->speedLabel->setText(QString("%1 m/s").arg(drone->getSpeed(), 0, 'f', 1));
+    profiler->lap(TickProfiler::UI_REFRESH_PHASE, refreshStart);
+}
+
+void MainWindow::updateFleetTable()
+{
+    QTableView* view = ui->fleetTableView;
+    int firstRow = view->rowAt(0);
+    int lastRow = view->rowAt(view->viewport()->height() - 1);
+    if (lastRow < 0)
+    {
+        lastRow = _fleetTableModel->rowCount() - 1; // Table shorter than the viewport
+    }
     
-    // Update battery and GPS fix
-    updateBatteryDisplay();
-    updateGpsFixDisplay();
+    _fleetTableModel->setVisibleRows(firstRow, lastRow);
+    _fleetTableModel->setFleet(_snapshotBuffer->current().fleet);
 }
 
-void MainWindow::updateBatteryDisplay()
+void MainWindow::updateTelemetryDisplay(quint32 changedFields)
 {
-    if (!_telemetryModel->getDrone())
+    if (changedFields == TelemetryField::NONE)
     {
         return;
     }
     
-    int battery = _telemetryModel->getDrone()->getBattery();
-    ui->batteryProgressBar->setValue(battery);
+    Drone* drone = _telemetryModel->getDrone();
+    if (!drone)
+    {
+        return;
+    }
     
-    // Change color based on battery level
-    if (battery <= 20)
+    const FleetState& fleet = _snapshotBuffer->current().fleet;
+    int index = drone->getIndex();
+    if (index >= fleet.size())
     {
-        ui->batteryProgressBar->setStyleSheet("QProgressBar::chunk { background-color: #DC3545; }");
+        return;
     }
-    else if (battery <= 50)
+    
+    // Update only the telemetry labels whose fields changed
+    if (changedFields == TelemetryField::ALL)
     {
-        ui->batteryProgressBar->setStyleSheet("QProgressBar::chunk { background-color: #FFC107; }");
+        setLabelText(ui->droneIdLabel, fleet.name(index));
     }
-    else
+    if (changedFields & TelemetryField::LATITUDE)
+    {
+        setLabelText(ui->latitudeLabel, QString::number(fleet.latitudes()[index], 'f', 6));
+    }
+    if (changedFields & TelemetryField::LONGITUDE)
+    {
+        setLabelText(ui->longitudeLabel, QString::number(fleet.longitudes()[index], 'f', 6));
+    }
+    if (changedFields & TelemetryField::ALTITUDE)
+    {
+        setLabelText(ui->altitudeLabel, QString("%1 m").arg(fleet.altitudes()[index], 0, 'f', 1));
+    }
+    if (changedFields & TelemetryField::HEADING)
+    {
+        setLabelText(ui->headingLabel, QString("%1°").arg(fleet.headings()[index], 0, 'f', 1));
+    }
+    if (changedFields & TelemetryField::SPEED)
+    {
+        setLabelText(ui->speedLabel, QString("%1 m/s").arg(fleet.speeds()[index], 0, 'f', 1));
+    }
+    
+    // Update battery and GPS fix
+    if (changedFields & TelemetryField::BATTERY)
     {
-        ui->batteryProgressBar->setStyleSheet("QProgressBar::chunk { background-color: #28A745; }");
+        updateBatteryDisplay(fleet.batteries()[index]);
+    }
+    if (changedFields & TelemetryField::GPS_FIX)
+    {
+        updateGpsFixDisplay(fleet.gpsFixStatuses()[index]);
     }
 }
 
-void MainWindow::updateGpsFixDisplay()
+void MainWindow::setLabelText(QLabel* label, const QString& text)
 {
-    if (!_telemetryModel->getDrone())
+    // Most ticks move a value by less than its displayed precision
+    if (label->text() != text)
     {
-        return;
+        label->setText(text);
     }
+}
+
+void MainWindow::initializeDisplayPalettes()
+{
+    const QColor green("#28A745");
+    const QColor yellow("#FFC107");
+    const QColor red("#DC3545");
     
-    QString gpsStatus = _telemetryModel->getDrone()->getGpsFixStatusString();
-    ui->gpsFixLabel->setText(gpsStatus);
+    // Palette colours are applied without the style re-polish a stylesheet forces;
+    // the Fusion style draws the progress bar chunk in the Highlight colour
+    const QColor bandColors[BATTERY_BAND_COUNT] = {green, yellow, red};
+    for (int band = 0; band < BATTERY_BAND_COUNT; ++band)
+    {
+        _batteryPalettes[band] = ui->batteryProgressBar->palette();
+        _batteryPalettes[band].setColor(QPalette::Highlight, bandColors[band]);
+    }
     
-    // Change color based on GPS status
-    if (gpsStatus == "No Fix")
+    // Indexed by GPSFixStatus: NO_FIX, FIX_2D, FIX_3D
+    const QColor fixColors[GPS_FIX_STATUS_COUNT] = {red, yellow, green};
+    for (int status = 0; status < GPS_FIX_STATUS_COUNT; ++status)
     {
-        ui->gpsFixLabel->setStyleSheet("font-weight: bold; color: #DC3545;");
+        _gpsFixPalettes[status] = ui->gpsFixLabel->palette();
+        _gpsFixPalettes[status].setColor(QPalette::WindowText, fixColors[status]);
     }
-    else if (gpsStatus == "2D Fix")
+}
+
+void MainWindow::updateBatteryDisplay(int battery)
+{
+    ui->batteryProgressBar->setValue(battery);
+    
+    // Change color based on battery level
+    int band = BATTERY_GREEN;
+    if (battery <= 20)
     {
-        ui->gpsFixLabel->setStyleSheet("font-weight: bold; color: #FFC107;");
+        band = BATTERY_RED;
     }
-    else
+    else if (battery <= 50)
     {
-        ui->gpsFixLabel->setStyleSheet("font-weight: bold; color: #28A745;");
+        band = BATTERY_YELLOW;
     }
+    
+    if (band != _batteryBand)
+    {
+        _batteryBand = band;
+        ui->batteryProgressBar->setPalette(_batteryPalettes[band]);
+    }
+}
+
+void MainWindow::updateGpsFixDisplay(GPSFixStatus status)
+{
+    int statusIndex = static_cast<int>(status);
+    if (statusIndex == _gpsFixStatus || statusIndex >= GPS_FIX_STATUS_COUNT)
+    {
+        return;
+    }
+    
+    _gpsFixStatus = statusIndex;
+    ui->gpsFixLabel->setText(Drone::gpsFixStatusToString(status));
+    ui->gpsFixLabel->setPalette(_gpsFixPalettes[statusIndex]);
 }
 
 void MainWindow::setStatusMessage(const QString& message, const QString& color)
@@ -1,6 +1,21 @@
 #include "movementstrategy.h"
+#include "drone.h"
  
 MovementStrategy::MovementStrategy(QObject* parent)
     : QObject(parent)
 {
-} 
\ No newline at end of file
+}
+
+void MovementStrategy::updatePosition(Drone* drone, const TickContext& context)
+{
+    if (!drone)
+    {
+        return;
+    }
+    
+    drone->beginUpdate();
+    updatePositions(drone->getFleet()->slice(drone->getIndex(), 1), context);
+    drone->markChanged(TelemetryField::KINEMATICS);
+    drone->commitUpdate();
+}
+
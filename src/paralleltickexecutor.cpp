@@ -0,0 +1,196 @@
+#include "paralleltickexecutor.h"
+#include "logger.h"
+#include <QThread>
+
+namespace
+{
+/**
+ * @brief Pack a [begin, end) task range into one atomically updatable word
+ */
+inline quint64 packRange(quint32 begin, quint32 end)
+{
+    return (static_cast<quint64>(begin) << 32) | end;
+}
+
+inline quint32 rangeBegin(quint64 range)
+{
+    return static_cast<quint32>(range >> 32);
+}
+
+inline quint32 rangeEnd(quint64 range)
+{
+    return static_cast<quint32>(range);
+}
+}
+
+ParallelTickExecutor::ParallelTickExecutor(int threadCount)
+    : _threadCount(threadCount > 0 ? threadCount : qMax(1, QThread::idealThreadCount()))
+    , _queues(new TaskQueue[_threadCount])
+    , _task(nullptr)
+    , _activeWorkers(0)
+    , _generation(0)
+    , _stopping(false)
+{
+    for (int worker = 1; worker < _threadCount; ++worker)
+    {
+        QThread* thread = QThread::create([this, worker]() { workerLoop(worker); });
+        thread->setObjectName(QString("TickWorker-%1").arg(worker));
+        thread->start();
+        _threads.append(thread);
+    }
+
+    LOG_INFO(QString("ParallelTickExecutor started with %1 thread(s)").arg(_threadCount));
+}
+
+ParallelTickExecutor::~ParallelTickExecutor()
+{
+    {
+        QMutexLocker locker(&_mutex);
+        _stopping = true;
+    }
+    _batchReady.wakeAll();
+
+    for (QThread* thread : _threads)
+    {
+        thread->wait();
+        delete thread;
+    }
+}
+
+void ParallelTickExecutor::run(int taskCount, const std::function<void(int)>& task)
+{
+    if (taskCount <= 0)
+    {
+        return;
+    }
+
+    // Not worth waking the pool for a single task
+    if (_threadCount == 1 || taskCount == 1)
+    {
+        for (int i = 0; i < taskCount; ++i)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    // Deal out contiguous, equally sized ranges; stealing evens out the rest
+    for (int worker = 0; worker < _threadCount; ++worker)
+    {
+        quint32 begin = static_cast<quint32>(static_cast<qint64>(taskCount) * worker / _threadCount);
+        quint32 end = static_cast<quint32>(static_cast<qint64>(taskCount) * (worker + 1) / _threadCount);
+        _queues[worker].range.store(packRange(begin, end), std::memory_order_relaxed);
+    }
+
+    {
+        // The mutex release publishes the ranges and the task to the pool
+        QMutexLocker locker(&_mutex);
+        _task = &task;
+        _activeWorkers = _threadCount - 1;
+        ++_generation;
+    }
+    _batchReady.wakeAll();
+
+    // The calling thread works too, then waits at the barrier
+    drain(0);
+
+    QMutexLocker locker(&_mutex);
+    while (_activeWorkers > 0)
+    {
+        _batchDone.wait(&_mutex);
+    }
+    _task = nullptr;
+}
+
+void ParallelTickExecutor::workerLoop(int worker)
+{
+    quint64 seenGeneration = 0;
+
+    while (true)
+    {
+        {
+            QMutexLocker locker(&_mutex);
+            while (!_stopping && _generation == seenGeneration)
+            {
+                _batchReady.wait(&_mutex);
+            }
+            if (_stopping)
+            {
+                return;
+            }
+            seenGeneration = _generation;
+        }
+
+        drain(worker);
+
+        QMutexLocker locker(&_mutex);
+        if (--_activeWorkers == 0)
+        {
+            _batchDone.wakeAll();
+        }
+    }
+}
+
+void ParallelTickExecutor::drain(int worker)
+{
+    const std::function<void(int)>& task = *_task;
+
+    do
+    {
+        for (int index = popOwn(worker); index >= 0; index = popOwn(worker))
+        {
+            task(index);
+        }
+    } while (steal(worker));
+}
+
+int ParallelTickExecutor::popOwn(int worker)
+{
+    std::atomic<quint64>& range = _queues[worker].range;
+    quint64 current = range.load(std::memory_order_acquire);
+
+    while (true)
+    {
+        quint32 begin = rangeBegin(current);
+        quint32 end = rangeEnd(current);
+        if (begin >= end)
+        {
+            return -1;
+        }
+        if (range.compare_exchange_weak(current, packRange(begin + 1, end),
+                                        std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return static_cast<int>(begin);
+        }
+    }
+}
+
+bool ParallelTickExecutor::steal(int worker)
+{
+    for (int offset = 1; offset < _threadCount; ++offset)
+    {
+        std::atomic<quint64>& victim = _queues[(worker + offset) % _threadCount].range;
+        quint64 current = victim.load(std::memory_order_acquire);
+
+        while (true)
+        {
+            quint32 begin = rangeBegin(current);
+            quint32 end = rangeEnd(current);
+            if (begin >= end)
+            {
+                break;
+            }
+
+            // Take the back half (rounded up), leaving the victim the front it is working through
+            quint32 split = end - (end - begin + 1) / 2;
+            if (victim.compare_exchange_weak(current, packRange(begin, split),
+                                             std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                // Our own range is empty, so no thief touches it until this store
+                _queues[worker].range.store(packRange(split, end), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,70 @@
+#include "profilerpanel.h"
+#include "tickprofiler.h"
+#include <QFileDialog>
+#include <QFontDatabase>
+#include <QHBoxLayout>
+#include <QMessageBox>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QTimer>
+#include <QVBoxLayout>
+
+ProfilerPanel::ProfilerPanel(TickProfiler* profiler, QWidget* parent)
+    : QDialog(parent)
+    , _profiler(profiler)
+    , _reportView(new QPlainTextEdit(this))
+    , _refreshTimer(new QTimer(this))
+{
+    setWindowTitle("Tick Profiler");
+    resize(760, 320);
+    
+    _reportView->setReadOnly(true);
+    _reportView->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    _reportView->setLineWrapMode(QPlainTextEdit::NoWrap);
+    
+    QPushButton* resetButton = new QPushButton("Reset", this);
+    QPushButton* saveButton = new QPushButton("Save Report...", this);
+    QPushButton* closeButton = new QPushButton("Close", this);
+    
+    QHBoxLayout* buttonLayout = new QHBoxLayout();
+    buttonLayout->addWidget(resetButton);
+    buttonLayout->addWidget(saveButton);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(closeButton);
+    
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->addWidget(_reportView);
+    layout->addLayout(buttonLayout);
+    
+    connect(resetButton, &QPushButton::clicked, this, &ProfilerPanel::onResetButtonClicked);
+    connect(saveButton, &QPushButton::clicked, this, &ProfilerPanel::onSaveButtonClicked);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::hide);
+    connect(_refreshTimer, &QTimer::timeout, this, &ProfilerPanel::refresh);
+    
+    _refreshTimer->setInterval(REFRESH_INTERVAL_MS);
+    _refreshTimer->start();
+}
+
+void ProfilerPanel::refresh()
+{
+    if (isVisible())
+    {
+        _reportView->setPlainText(_profiler->formatReport());
+    }
+}
+
+void ProfilerPanel::onResetButtonClicked()
+{
+    _profiler->reset();
+    refresh();
+}
+
+void ProfilerPanel::onSaveButtonClicked()
+{
+    QString path = QFileDialog::getSaveFileName(this, "Save Tick Profile", "tick-profile.txt",
+                                                "Text files (*.txt);;All files (*)");
+    if (!path.isEmpty() && !_profiler->writeReport(path))
+    {
+        QMessageBox::warning(this, "Tick Profiler", QString("Failed to write %1").arg(path));
+    }
+}
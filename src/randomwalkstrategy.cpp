@@ -1,8 +1,6 @@
 #include "randomwalkstrategy.h"
-#include "drone.h"
+#include "kinematics.h"
 #include "logger.h"
-#include <QRandomGenerator>
-#include <QtMath>
 
 RandomWalkStrategy::RandomWalkStrategy(QObject* parent)
     : MovementStrategy(parent)
@@ -10,33 +8,34 @@ RandomWalkStrategy::RandomWalkStrategy(QObject* parent)
     LOG_DEBUG("RandomWalkStrategy created");
 }
 
-void RandomWalkStrategy::updatePosition(Drone* drone)
+void RandomWalkStrategy::updatePositions(const FleetSlice& slice, const TickContext& context)
 {
-    if (!drone)
+    const KinematicsKernels& kernels = Kinematics::kernels();
+    double samples[Kinematics::CHUNK_SIZE];
+    double noise = noiseScale(context.dt);
+    
+    for (int begin = 0; begin < slice.count; begin += Kinematics::CHUNK_SIZE)
     {
-        return;
+        int count = qMin(Kinematics::CHUNK_SIZE, slice.count - begin);
+        quint32 firstIndex = static_cast<quint32>(slice.begin + begin);
+        
+        // Random walk behavior: more significant movement
+        context.rng.fillUniform(samples, count, 200, context.tick, firstIndex, LATITUDE_STREAM);
+        kernels.addScaled(slice.latitudes + begin, samples, count, 100.0, 0.00001 * noise); // Larger changes
+        context.rng.fillUniform(samples, count, 200, context.tick, firstIndex, LONGITUDE_STREAM);
+        kernels.addScaled(slice.longitudes + begin, samples, count, 100.0, 0.00001 * noise);
+        context.rng.fillUniform(samples, count, 50, context.tick, firstIndex, ALTITUDE_STREAM);
+        kernels.addScaled(slice.altitudes + begin, samples, count, 25.0, 0.5 * noise); // Moderate altitude changes
+        
+        // More significant heading changes, normalized to 0-360 range
+        context.rng.fillUniform(samples, count, 60, context.tick, firstIndex, HEADING_STREAM);
+        kernels.addScaled(slice.headings + begin, samples, count, 30.0, 1.0 * noise);
+        kernels.wrapHeadings(slice.headings + begin, count);
+        
+        // Variable speed for random walk
+        context.rng.fillUniform(samples, count, 15, context.tick, firstIndex, SPEED_STREAM);
+        kernels.setScaled(slice.speeds + begin, samples, count, -5.0, 1.0); // 5-20 m/s
     }
-
-    // Random walk behavior: more significant movement
-    double latChange = (QRandomGenerator::global()->bounded(200) - 100) * 0.00001; // Larger changes
-    double lonChange = (QRandomGenerator::global()->bounded(200) - 100) * 0.00001;
-    double altChange = (QRandomGenerator::global()->bounded(50) - 25) * 0.5; // Moderate altitude changes
-    
-    drone->setLatitude(drone->getLatitude() + latChange);
-    drone->setLongitude(drone->getLongitude() + lonChange);
-    drone->setAltitude(drone->getAltitude() + altChange);
-    
-    // More significant heading changes
-    double headingChange = (QRandomGenerator::global()->bounded(60) - 30);
-    drone->setHeading(drone->getHeading() + headingChange);
-    
-    // Normalize heading to 0-360 range
-    while (drone->getHeading() >= 360.0) drone->setHeading(drone->getHeading() - 360.0);
-    while (drone->getHeading() < 0.0) drone->setHeading(drone->getHeading() + 360.0);
-    
-    // Variable speed for random walk
-    double speed = QRandomGenerator::global()->bounded(15) + 5; // 5-20 m/s
-    drone->setSpeed(speed);
 }
 
 QString RandomWalkStrategy::getStrategyName() const
@@ -0,0 +1,194 @@
+#include "separationmonitor.h"
+#include "fleetstate.h"
+#include "paralleltickexecutor.h"
+#include "spatialindex.h"
+#include <algorithm>
+#include <cmath>
+
+SeparationMonitor::SeparationMonitor(double horizontalMinimum, double verticalMinimum)
+    : _horizontalMinimum(horizontalMinimum > 0.0 ? horizontalMinimum : DEFAULT_HORIZONTAL_MINIMUM)
+    , _verticalMinimum(verticalMinimum > 0.0 ? verticalMinimum : DEFAULT_VERTICAL_MINIMUM)
+    , _conflictCount(0)
+    , _startedCount(0)
+{
+}
+
+void SeparationMonitor::setMinima(double horizontalMinimum, double verticalMinimum)
+{
+    if (horizontalMinimum > 0.0)
+    {
+        _horizontalMinimum = horizontalMinimum;
+    }
+    if (verticalMinimum > 0.0)
+    {
+        _verticalMinimum = verticalMinimum;
+    }
+}
+
+void SeparationMonitor::reset()
+{
+    _conflicts.clear();
+    _newConflicts.clear();
+    _activeKeys.clear();
+    _previousKeys.clear();
+    _conflictCount = 0;
+    _startedCount = 0;
+}
+
+void SeparationMonitor::detect(const FleetState& fleet, const SpatialIndex& index, ParallelTickExecutor* executor)
+{
+    int count = qMin(fleet.size(), index.size());
+    int chunkCount = (count + DETECT_CHUNK_SIZE - 1) / DETECT_CHUNK_SIZE;
+    if (_chunkConflicts.size() < chunkCount)
+    {
+        _chunkConflicts.resize(chunkCount);
+    }
+    _chunkCounts.fill(0, chunkCount);
+
+    if (_chunkCarriedKeys.size() < chunkCount)
+    {
+        _chunkCarriedKeys.resize(chunkCount);
+    }
+
+    // Take the pointers here so the workers never touch the containers themselves
+    QVector<SeparationConflict>* chunkConflicts = _chunkConflicts.data();
+    QVector<quint64>* chunkCarriedKeys = _chunkCarriedKeys.data();
+    qint64* chunkCounts = _chunkCounts.data();
+    auto runChunk = [&](int chunk) {
+        int begin = chunk * DETECT_CHUNK_SIZE;
+        chunkCounts[chunk] = detectChunk(fleet, index, begin, qMin(count, begin + DETECT_CHUNK_SIZE),
+                                         chunkConflicts[chunk], chunkCarriedKeys[chunk]);
+    };
+    if (executor && chunkCount > 1)
+    {
+        executor->run(chunkCount, runChunk);
+    }
+    else
+    {
+        for (int chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            runChunk(chunk);
+        }
+    }
+
+    // Chunks cover ascending slot ranges, so concatenating them keeps the slot order
+    _conflicts.clear();
+    _conflictCount = 0;
+    QVector<quint64> carriedKeys;
+    for (int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        _conflictCount += chunkCounts[chunk];
+        carriedKeys.append(chunkCarriedKeys[chunk]);
+        const QVector<SeparationConflict>& found = chunkConflicts[chunk];
+        int kept = qMin(found.size(), MAX_REPORTED_CONFLICTS - _conflicts.size());
+        for (int i = 0; i < found.size(); ++i)
+        {
+            if (i < kept)
+            {
+                _conflicts.append(found[i]);
+                continue;
+            }
+            quint64 key = pairKey(found[i].firstId, found[i].secondId);
+            if (std::binary_search(_activeKeys.constBegin(), _activeKeys.constEnd(), key))
+            {
+                carriedKeys.append(key);
+            }
+        }
+    }
+
+    // A conflict is new unless the same two drones were in conflict last time. Conflicts not
+    // kept stay tracked if they already were, so they are not reported again once kept
+    _previousKeys.swap(_activeKeys);
+    _activeKeys = carriedKeys;
+    _newConflicts.clear();
+    for (const SeparationConflict& conflict : _conflicts)
+    {
+        quint64 key = pairKey(conflict.firstId, conflict.secondId);
+        _activeKeys.append(key);
+        if (!std::binary_search(_previousKeys.constBegin(), _previousKeys.constEnd(), key))
+        {
+            _newConflicts.append(conflict);
+        }
+    }
+    std::sort(_activeKeys.begin(), _activeKeys.end());
+    _startedCount += _newConflicts.size();
+}
+
+qint64 SeparationMonitor::detectChunk(const FleetState& fleet, const SpatialIndex& index, int begin, int end,
+                                      QVector<SeparationConflict>& found, QVector<quint64>& carriedKeys) const
+{
+    found.clear();
+    carriedKeys.clear();
+    const double* xs = index.xs();
+    const double* ys = index.ys();
+    const double* altitudes = fleet.altitudes();
+    const DroneId* ids = fleet.ids();
+    double horizontal = _horizontalMinimum;
+    double horizontalSquared = horizontal * horizontal;
+    double vertical = _verticalMinimum;
+    qint64 conflictCount = 0;
+
+    for (int i = begin; i < end; ++i)
+    {
+        // Once the chunk holds MAX_REPORTED_CONFLICTS, later drones' conflicts are only counted
+        // and, if already tracked, carried over
+        bool full = found.size() >= MAX_REPORTED_CONFLICTS;
+        int first = found.size();
+        double x = xs[i];
+        double y = ys[i];
+        double altitude = altitudes[i];
+        int maxCellX = index.cellCoordinate(x + horizontal);
+        int maxCellY = index.cellCoordinate(y + horizontal);
+        for (int cellX = index.cellCoordinate(x - horizontal); cellX <= maxCellX; ++cellX)
+        {
+            for (int cellY = index.cellCoordinate(y - horizontal); cellY <= maxCellY; ++cellY)
+            {
+                index.forEachInCell(cellX, cellY, [&](int j) {
+                    // Each pair is checked from its lower slot only
+                    if (j <= i)
+                    {
+                        return;
+                    }
+                    double verticalDistance = std::fabs(altitudes[j] - altitude);
+                    double dx = xs[j] - x;
+                    double dy = ys[j] - y;
+                    double horizontalDistanceSquared = dx * dx + dy * dy;
+                    if (verticalDistance >= vertical || horizontalDistanceSquared >= horizontalSquared)
+                    {
+                        return;
+                    }
+                    ++conflictCount;
+                    if (!full)
+                    {
+                        found.append({i, j, ids[i], ids[j], std::sqrt(horizontalDistanceSquared), verticalDistance});
+                        return;
+                    }
+                    quint64 key = pairKey(ids[i], ids[j]);
+                    if (std::binary_search(_activeKeys.constBegin(), _activeKeys.constEnd(), key))
+                    {
+                        carriedKeys.append(key);
+                    }
+                });
+            }
+        }
+
+        // Neighbours arrive cell by cell; order them before any are cut off, so the kept ones
+        // are the lowest slots whatever the cell layout
+        std::sort(found.begin() + first, found.end(), [](const SeparationConflict& a, const SeparationConflict& b) {
+            return a.secondSlot < b.secondSlot;
+        });
+        for (int k = MAX_REPORTED_CONFLICTS; k < found.size(); ++k)
+        {
+            quint64 key = pairKey(found[k].firstId, found[k].secondId);
+            if (std::binary_search(_activeKeys.constBegin(), _activeKeys.constEnd(), key))
+            {
+                carriedKeys.append(key);
+            }
+        }
+        if (found.size() > MAX_REPORTED_CONFLICTS)
+        {
+            found.resize(MAX_REPORTED_CONFLICTS);
+        }
+    }
+    return conflictCount;
+}
@@ -0,0 +1,398 @@
+#include "spatialindex.h"
+#include "fleetstate.h"
+#include "paralleltickexecutor.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+constexpr double METRES_PER_DEGREE = 111320.0; // Metres per degree of latitude (and of longitude at the equator)
+constexpr int MIN_BUCKET_BITS = 10;            // Smallest bucket table (1024 buckets)
+constexpr int MAX_BUCKET_BITS = 30;
+constexpr int MAX_CELL_COORDINATE = 1 << 30;   // Clamp for positions absurdly far from the reference
+constexpr double MAX_REFERENCE_DRIFT = 10000.0; // Fleet centre distance (m) that moves the reference
+constexpr int MAX_MOVED_FRACTION = 8;          // Rebuild once more than 1/8 of the drones left their bucketed cell
+}
+
+SpatialIndex::SpatialIndex(double cellSize)
+    : _cellSize(cellSize > 0.0 ? cellSize : DEFAULT_CELL_SIZE)
+    , _referenceLatitude(0.0)
+    , _referenceLongitude(0.0)
+    , _metresPerDegreeLongitude(METRES_PER_DEGREE)
+    , _hasReference(false)
+    , _count(0)
+    , _layoutVersion(0)
+    , _rebuilt(false)
+    , _stale(true)
+    , _bucketBits(MIN_BUCKET_BITS)
+    , _bucketStart(1, 0)
+    , _bucketFillCapacity(0)
+{
+}
+
+void SpatialIndex::setCellSize(double cellSize)
+{
+    if (cellSize > 0.0 && cellSize != _cellSize)
+    {
+        _cellSize = cellSize;
+        _stale = true;
+    }
+}
+
+void SpatialIndex::clear()
+{
+    _hasReference = false;
+    _count = 0;
+    _rebuilt = false;
+    _stale = true;
+    _x.clear();
+    _y.clear();
+    _cellKeys.clear();
+    _entries.clear();
+    _bucketedKeys.clear();
+    _moved.clear();
+    _bucketStart.fill(0, 1);
+}
+
+void SpatialIndex::toLocal(double latitude, double longitude, double& x, double& y) const
+{
+    x = (longitude - _referenceLongitude) * _metresPerDegreeLongitude;
+    y = (latitude - _referenceLatitude) * METRES_PER_DEGREE;
+}
+
+int SpatialIndex::cellCoordinate(double metres) const
+{
+    double cell = std::floor(metres / _cellSize);
+    return static_cast<int>(qBound(-static_cast<double>(MAX_CELL_COORDINATE), cell,
+                                   static_cast<double>(MAX_CELL_COORDINATE)));
+}
+
+void SpatialIndex::update(const FleetState& fleet, ParallelTickExecutor* executor)
+{
+    int count = fleet.size();
+    if (count == 0)
+    {
+        bool hadDrones = _count > 0;
+        clear();
+        _rebuilt = hadDrones;
+        return;
+    }
+
+    bool resized = count != _count || fleet.getLayoutVersion() != _layoutVersion;
+    if (resized)
+    {
+        _x.resize(count);
+        _y.resize(count);
+        _cellKeys.resize(count);
+    }
+
+    double bounds[4];
+    bool moved = project(fleet, executor, bounds);
+
+    // Keep the reference at the centre of the fleet: move it when the slots change (spawns,
+    // despawns, another fleet) or the fleet has flown far from it, then project again
+    double centreX = (bounds[0] + bounds[1]) / 2.0;
+    double centreY = (bounds[2] + bounds[3]) / 2.0;
+    if (!_hasReference || resized || std::hypot(centreX, centreY) > MAX_REFERENCE_DRIFT)
+    {
+        _referenceLongitude += centreX / _metresPerDegreeLongitude;
+        _referenceLatitude += centreY / METRES_PER_DEGREE;
+        _metresPerDegreeLongitude = METRES_PER_DEGREE * qMax(1e-6, std::cos(qDegreesToRadians(_referenceLatitude)));
+        _hasReference = true;
+        project(fleet, executor, bounds);
+        moved = true;
+    }
+
+    _count = count;
+    _layoutVersion = fleet.getLayoutVersion();
+    _rebuilt = resized || _stale;
+    if (!_rebuilt && moved)
+    {
+        // Only positions changed: list the drones that left their cell instead of re-bucketing everyone
+        _rebuilt = !listMoved(executor);
+    }
+    if (_rebuilt)
+    {
+        rebuild(executor);
+    }
+}
+
+bool SpatialIndex::project(const FleetState& fleet, ParallelTickExecutor* executor, double* bounds)
+{
+    int count = fleet.size();
+    const double* latitudes = fleet.latitudes();
+    const double* longitudes = fleet.longitudes();
+    double* xs = _x.data();
+    double* ys = _y.data();
+    quint64* keys = _cellKeys.data();
+    int chunkCount = (count + UPDATE_CHUNK_SIZE - 1) / UPDATE_CHUNK_SIZE;
+    _chunkBounds.resize(chunkCount * 4);
+    double* chunkBounds = _chunkBounds.data();
+    std::atomic<bool> moved(false);
+    runTasks(executor, chunkCount, [&](int chunk) {
+        int begin = chunk * UPDATE_CHUNK_SIZE;
+        int end = qMin(count, begin + UPDATE_CHUNK_SIZE);
+        bool chunkMoved = false;
+        double minX = std::numeric_limits<double>::max();
+        double maxX = -minX;
+        double minY = minX;
+        double maxY = -minX;
+        for (int i = begin; i < end; ++i)
+        {
+            toLocal(latitudes[i], longitudes[i], xs[i], ys[i]);
+            minX = qMin(minX, xs[i]);
+            maxX = qMax(maxX, xs[i]);
+            minY = qMin(minY, ys[i]);
+            maxY = qMax(maxY, ys[i]);
+            quint64 key = cellKey(cellCoordinate(xs[i]), cellCoordinate(ys[i]));
+            chunkMoved |= key != keys[i];
+            keys[i] = key;
+        }
+        double* out = chunkBounds + chunk * 4;
+        out[0] = minX;
+        out[1] = maxX;
+        out[2] = minY;
+        out[3] = maxY;
+        if (chunkMoved)
+        {
+            moved.store(true, std::memory_order_relaxed);
+        }
+    });
+
+    bounds[0] = bounds[2] = std::numeric_limits<double>::max();
+    bounds[1] = bounds[3] = -std::numeric_limits<double>::max();
+    for (int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        const double* in = chunkBounds + chunk * 4;
+        bounds[0] = qMin(bounds[0], in[0]);
+        bounds[1] = qMax(bounds[1], in[1]);
+        bounds[2] = qMin(bounds[2], in[2]);
+        bounds[3] = qMax(bounds[3], in[3]);
+    }
+    return moved.load(std::memory_order_relaxed);
+}
+
+void SpatialIndex::rebuild(ParallelTickExecutor* executor)
+{
+    // Twice as many buckets as drones keeps most buckets down to a single cell
+    int bits = MIN_BUCKET_BITS;
+    while (bits < MAX_BUCKET_BITS && (1 << bits) < 2 * _count)
+    {
+        ++bits;
+    }
+    _bucketBits = bits;
+    int bucketCount = 1 << bits;
+    if (_bucketFillCapacity < bucketCount)
+    {
+        _bucketFill.reset(new std::atomic<int>[bucketCount]);
+        _bucketFillCapacity = bucketCount;
+    }
+    std::atomic<int>* fill = _bucketFill.get();
+    for (int bucket = 0; bucket < bucketCount; ++bucket)
+    {
+        fill[bucket].store(0, std::memory_order_relaxed);
+    }
+
+    const quint64* keys = _cellKeys.constData();
+    int count = _count;
+    int chunkCount = (count + UPDATE_CHUNK_SIZE - 1) / UPDATE_CHUNK_SIZE;
+    runTasks(executor, chunkCount, [&](int chunk) {
+        int end = qMin(count, (chunk + 1) * UPDATE_CHUNK_SIZE);
+        for (int i = chunk * UPDATE_CHUNK_SIZE; i < end; ++i)
+        {
+            fill[bucketOf(keys[i])].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    // Prefix sum; the counters become each bucket's write cursor
+    _bucketStart.resize(bucketCount + 1);
+    int* start = _bucketStart.data();
+    start[0] = 0;
+    for (int bucket = 0; bucket < bucketCount; ++bucket)
+    {
+        start[bucket + 1] = start[bucket] + fill[bucket].load(std::memory_order_relaxed);
+        fill[bucket].store(start[bucket], std::memory_order_relaxed);
+    }
+
+    _entries.resize(count);
+    int* entries = _entries.data();
+    runTasks(executor, chunkCount, [&](int chunk) {
+        int end = qMin(count, (chunk + 1) * UPDATE_CHUNK_SIZE);
+        for (int i = chunk * UPDATE_CHUNK_SIZE; i < end; ++i)
+        {
+            entries[fill[bucketOf(keys[i])].fetch_add(1, std::memory_order_relaxed)] = i;
+        }
+    });
+
+    // Scatter order depends on thread timing; sort each bucket so queries are deterministic
+    int bucketChunks = (bucketCount + UPDATE_CHUNK_SIZE - 1) / UPDATE_CHUNK_SIZE;
+    runTasks(executor, bucketChunks, [&](int chunk) {
+        int end = qMin(bucketCount, (chunk + 1) * UPDATE_CHUNK_SIZE);
+        for (int bucket = chunk * UPDATE_CHUNK_SIZE; bucket < end; ++bucket)
+        {
+            if (start[bucket + 1] - start[bucket] > 1)
+            {
+                std::sort(entries + start[bucket], entries + start[bucket + 1]);
+            }
+        }
+    });
+    _bucketedKeys = _cellKeys;
+    _moved.clear();
+    _stale = false;
+}
+
+bool SpatialIndex::listMoved(ParallelTickExecutor* executor)
+{
+    const quint64* keys = _cellKeys.constData();
+    const quint64* bucketedKeys = _bucketedKeys.constData();
+    int count = _count;
+    int chunkCount = (count + UPDATE_CHUNK_SIZE - 1) / UPDATE_CHUNK_SIZE;
+    if (_chunkMoved.size() < chunkCount)
+    {
+        _chunkMoved.resize(chunkCount);
+    }
+
+    // Take the pointer here so the workers never touch the container itself
+    QVector<quint64>* chunkMoved = _chunkMoved.data();
+    runTasks(executor, chunkCount, [&](int chunk) {
+        QVector<quint64>& moved = chunkMoved[chunk];
+        moved.clear();
+        int end = qMin(count, (chunk + 1) * UPDATE_CHUNK_SIZE);
+        for (int i = chunk * UPDATE_CHUNK_SIZE; i < end; ++i)
+        {
+            if (keys[i] != bucketedKeys[i])
+            {
+                moved.append((static_cast<quint64>(bucketOf(keys[i])) << 32) | static_cast<quint32>(i));
+            }
+        }
+    });
+
+    int movedCount = 0;
+    for (int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        movedCount += chunkMoved[chunk].size();
+    }
+    if (movedCount > count / MAX_MOVED_FRACTION)
+    {
+        return false;
+    }
+
+    _moved.clear();
+    _moved.reserve(movedCount);
+    for (int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        _moved.append(chunkMoved[chunk]);
+    }
+    std::sort(_moved.begin(), _moved.end());
+    return true;
+}
+
+void SpatialIndex::runTasks(ParallelTickExecutor* executor, int taskCount, const std::function<void(int)>& task)
+{
+    if (executor && taskCount > 1)
+    {
+        executor->run(taskCount, task);
+        return;
+    }
+    for (int i = 0; i < taskCount; ++i)
+    {
+        task(i);
+    }
+}
+
+void SpatialIndex::forEachInRect(double minX, double minY, double maxX, double maxY,
+                                 const std::function<void(int)>& visit) const
+{
+    if (_count == 0)
+    {
+        return;
+    }
+
+    int minCellX = cellCoordinate(minX);
+    int maxCellX = cellCoordinate(maxX);
+    int minCellY = cellCoordinate(minY);
+    int maxCellY = cellCoordinate(maxY);
+    double cellCount = (static_cast<double>(maxCellX) - minCellX + 1) * (static_cast<double>(maxCellY) - minCellY + 1);
+
+    // A rectangle spanning more cells than there are drones is cheaper to answer with a scan
+    if (cellCount > _count)
+    {
+        for (int slot = 0; slot < _count; ++slot)
+        {
+            visit(slot);
+        }
+        return;
+    }
+
+    for (int cellX = minCellX; cellX <= maxCellX; ++cellX)
+    {
+        for (int cellY = minCellY; cellY <= maxCellY; ++cellY)
+        {
+            forEachInCell(cellX, cellY, visit);
+        }
+    }
+}
+
+void SpatialIndex::queryRadius(double latitude, double longitude, double radiusMetres, QVector<int>& result) const
+{
+    result.clear();
+    double x = 0.0;
+    double y = 0.0;
+    toLocal(latitude, longitude, x, y);
+    double radiusSquared = radiusMetres * radiusMetres;
+
+    forEachInRect(x - radiusMetres, y - radiusMetres, x + radiusMetres, y + radiusMetres, [&](int slot) {
+        double dx = _x[slot] - x;
+        double dy = _y[slot] - y;
+        if (dx * dx + dy * dy <= radiusSquared)
+        {
+            result.append(slot);
+        }
+    });
+    std::sort(result.begin(), result.end());
+}
+
+void SpatialIndex::queryBox(double minLatitude, double minLongitude, double maxLatitude, double maxLongitude,
+                            QVector<int>& result) const
+{
+    result.clear();
+    double minX = 0.0;
+    double minY = 0.0;
+    double maxX = 0.0;
+    double maxY = 0.0;
+    toLocal(minLatitude, minLongitude, minX, minY);
+    toLocal(maxLatitude, maxLongitude, maxX, maxY);
+
+    forEachInRect(minX, minY, maxX, maxY, [&](int slot) {
+        if (_x[slot] >= minX && _x[slot] <= maxX && _y[slot] >= minY && _y[slot] <= maxY)
+        {
+            result.append(slot);
+        }
+    });
+    std::sort(result.begin(), result.end());
+}
+
+int SpatialIndex::nearest(double latitude, double longitude, double maxDistanceMetres) const
+{
+    double x = 0.0;
+    double y = 0.0;
+    toLocal(latitude, longitude, x, y);
+    double bestSquared = maxDistanceMetres * maxDistanceMetres;
+    int best = -1;
+
+    forEachInRect(x - maxDistanceMetres, y - maxDistanceMetres, x + maxDistanceMetres, y + maxDistanceMetres,
+                  [&](int slot) {
+        double dx = _x[slot] - x;
+        double dy = _y[slot] - y;
+        double distanceSquared = dx * dx + dy * dy;
+        // Ties go to the lower slot so the answer does not depend on visiting order
+        if (distanceSquared < bestSquared || (distanceSquared == bestSquared && (best < 0 || slot < best)))
+        {
+            bestSquared = distanceSquared;
+            best = slot;
+        }
+    });
+    return best;
+}
@@ -0,0 +1,31 @@
+#include "strategyfactory.h"
+#include "hoverstrategy.h"
+#include "randomwalkstrategy.h"
+
+MovementStrategy* StrategyFactory::getSharedStrategy(StrategyType type)
+{
+    // Never destroyed, so models torn down at exit never see a dangling strategy
+    static MovementStrategy* const strategies[STRATEGY_TYPE_COUNT] = {
+        new HoverStrategy(),
+        new RandomWalkStrategy()
+    };
+
+    if (type < 0 || type >= STRATEGY_TYPE_COUNT)
+    {
+        return nullptr;
+    }
+    return strategies[type];
+}
+
+StrategyFactory::StrategyType StrategyFactory::strategyTypeFromName(const QString& name)
+{
+    if (name == "hover")
+    {
+        return HOVER_STRATEGY;
+    }
+    if (name == "randomwalk")
+    {
+        return RANDOM_WALK_STRATEGY;
+    }
+    return STRATEGY_TYPE_COUNT;
+}
@@ -1,42 +1,64 @@
 #include "telemetrymodel.h"
 #include "drone.h"
 #include "movementstrategy.h"
-#include "hoverstrategy.h"
-#include "randomwalkstrategy.h"
+#include "strategyfactory.h"
 #include "dronefactory.h"
+#include "dronenametable.h"
+#include "dronepool.h"
+#include "paralleltickexecutor.h"
+#include "telemetryrecorder.h"
 #include "logger.h"
-#include <QTimer>
+#include <QDateTime>
+#include <QRandomGenerator>
 #include <QDebug>
 
+namespace
+{
+constexpr int TICK_CHUNK_SIZE = 1024; // Drones per parallel tick task
+constexpr int MAX_DRONE_STRATEGIES = 256; // Strategy IDs are stored as quint8
+constexpr qint64 CONFLICT_REPORT_INTERVAL_NS = 1000000000ll; // Least time between separation conflict log lines
+}
+
 TelemetryModel::TelemetryModel(QObject* parent)
     : QObject(parent)
     , _drone(nullptr)
+    , _dronePool(new DronePool(this))
     , _currentStrategy(nullptr)
-    , _simulationTimer(new QTimer(this))
+    , _droneStrategies(1, nullptr)
+    , _threadCount(0)
+    , _simulationRunning(false)
     , _failureSimulationActive(false)
+    , _tick(0)
+    , _simulationTime(0.0)
+    , _rng(QRandomGenerator::global()->generate64())
+    , _nextDroneNumber(2) // DRONE-001 is created below
+    , _notifyFields(TelemetryField::NONE)
+    , _spatialIndexDirty(true)
+    , _separationMonitoringEnabled(false)
+    , _lastConflictReportNs(-CONFLICT_REPORT_INTERVAL_NS)
 {
     try
     {
         LOG_DEBUG("TelemetryModel created");
         
-        qDebug() << "TelemetryModel: Creating simulation timer...";
-        
-        // Set up simulation timer for 500ms updates
-        _simulationTimer->setInterval(500);
-        connect(_simulationTimer, &QTimer::timeout, this, &TelemetryModel::updateTelemetry);
+        // Conflicts are delivered to other threads through queued connections
+        qRegisterMetaType<QVector<SeparationConflict>>("QVector<SeparationConflict>");
         
         qDebug() << "TelemetryModel: Creating default drone...";
         
-        // Create default drone using factory
-        _drone = DroneFactory::createDrone("DRONE-001", this);
-        connect(_drone, &Drone::telemetryUpdated, this, &TelemetryModel::onDroneTelemetryUpdated);
+        // Create default drone in the fleet using factory
+        _drone = DroneFactory::acquireDrone(_dronePool, &_fleet, "DRONE-001");
         
         qDebug() << "TelemetryModel: Initializing default movement strategy...";
         
         // Initialize default movement strategy
         initializeDefaultStrategy();
         
+        // Publish the initial state so the UI has something to show before the first tick
+        publishSnapshot(TelemetryField::ALL);
+        
         LOG_INFO("TelemetryModel initialized with default drone and hover strategy");
+        LOG_INFO(QString("Simulation seed: %1").arg(_rng.getSeed()));
         
     }
     catch (const std::exception& e)
@@ -54,50 +76,312 @@ TelemetryModel::TelemetryModel(QObject* parent)
 TelemetryModel::~TelemetryModel()
 {
     stopSimulation();
+    stopRecording();
     LOG_DEBUG("TelemetryModel destroyed");
 }
 
 void TelemetryModel::setDrone(Drone* drone)
 {
+    QMutexLocker locker(&_mutex);
+    
     if (_drone != drone)
     {
+        _drone = drone;
+        
         if (_drone)
         {
-            disconnect(_drone, &Drone::telemetryUpdated, this, &TelemetryModel::onDroneTelemetryUpdated);
+            LOG_INFO(QString("Drone changed to: %1").arg(_drone->getName()));
+            _spatialIndexDirty = true; // May be another fleet
+            publishSnapshot(TelemetryField::ALL);
         }
+    }
+}
+
+void TelemetryModel::selectDrone(int droneIndex)
+{
+    Drone* drone = nullptr;
+    bool failureActive = false;
+    {
+        QMutexLocker locker(&_mutex);
         
+        if (droneIndex < 0 || droneIndex >= _fleet.size() || (_drone && _drone->getIndex() == droneIndex))
+        {
+            return;
+        }
+        
+        // Views we created ourselves go back to the pool; the next one is usually the same object
+        if (_drone && _drone->parent() == _dronePool)
+        {
+            _dronePool->release(_drone);
+        }
+        
+        drone = _dronePool->acquire(&_fleet, droneIndex);
         _drone = drone;
+        _failureSimulationActive = _fleet.failureModes()[droneIndex] != 0;
+        failureActive = _failureSimulationActive;
+        publishSnapshot(TelemetryField::ALL);
+    }
+    
+    LOG_INFO(QString("Current drone changed to: %1").arg(drone->getName()));
+    emit droneChanged(drone);
+    emit failureSimulationToggled(failureActive);
+}
+
+void TelemetryModel::resizeFleet(int droneCount)
+{
+    QMutexLocker locker(&_mutex);
+    
+    int previousSize = _fleet.size();
+    if (droneCount <= previousSize)
+    {
+        return;
+    }
+    
+    // Grow every array once; the new drones keep the default position
+    int added = droneCount - previousSize;
+    int first = _fleet.addDrones(added);
+    int named = DroneFactory::assignGeneratedIds(&_fleet, first, added, "DRONE-", &_nextDroneNumber, &_freeDroneIds);
+    if (named < added)
+    {
+        // Drop the drones the name table had no room for, from the end
+        for (int slot = _fleet.size(); slot-- > first + named;)
+        {
+            _fleet.removeDrone(slot);
+        }
+        LOG_ERROR(QString("Drone name table is full: fleet grew to %1 of %2 drones").arg(_fleet.size()).arg(droneCount));
+    }
+    _spatialIndexDirty = true;
+    publishSnapshot(TelemetryField::NONE);
+    
+    LOG_INFO(QString("Fleet resized from %1 to %2 drones").arg(previousSize).arg(_fleet.size()));
+}
+
+int TelemetryModel::spawnDrones(const SpawnDescriptor& descriptor)
+{
+    QMutexLocker locker(&_mutex);
+    
+    SpawnDescriptor numbered = descriptor;
+    numbered.firstNumber = _nextDroneNumber;
+    int spawned = DroneFactory::spawnDrones(&_fleet, numbered, &_nextDroneNumber, &_freeDroneIds);
+    if (spawned > 0)
+    {
+        _spatialIndexDirty = true;
+        publishSnapshot(TelemetryField::NONE);
+    }
+    return spawned;
+}
+
+bool TelemetryModel::removeDrone(int droneIndex)
+{
+    Drone* newDrone = nullptr;
+    bool failureChanged = false;
+    bool failureActive = false;
+    {
+        QMutexLocker locker(&_mutex);
         
-        if (_drone)
+        if (droneIndex < 0 || droneIndex >= _fleet.size() || _fleet.size() == 1)
+        {
+            LOG_WARNING(QString("Cannot remove drone slot %1: out of range or the only drone").arg(droneIndex));
+            return false;
+        }
+        
+        int currentIndex = _drone && _drone->getFleet() == &_fleet ? _drone->getIndex() : -1;
+        _freeDroneIds.append(_fleet.id(droneIndex));
+        int movedFrom = _fleet.removeDrone(droneIndex);
+        
+        if (currentIndex == droneIndex)
         {
-            connect(_drone, &Drone::telemetryUpdated, this, &TelemetryModel::onDroneTelemetryUpdated);
-            LOG_INFO(QString("Drone changed to: %1").arg(_drone->getId()));
+            // The current drone is gone; whichever drone now holds its slot takes over
+            if (_drone->parent() == _dronePool)
+            {
+                _dronePool->release(_drone);
+            }
+            newDrone = _dronePool->acquire(&_fleet, qMin(droneIndex, _fleet.size() - 1));
+            _drone = newDrone;
+            failureActive = _fleet.failureModes()[_drone->getIndex()] != 0;
+            failureChanged = failureActive != _failureSimulationActive;
+            _failureSimulationActive = failureActive;
         }
+        else if (currentIndex >= 0 && currentIndex == movedFrom)
+        {
+            // Same drone, new slot
+            _drone->attach(&_fleet, droneIndex);
+        }
+        _spatialIndexDirty = true;
+        publishSnapshot(TelemetryField::ALL);
+    }
+    
+    // Swarms despawn thousands of drones per second; keep this out of the default log
+    LOG_DEBUG(QString("Drone slot %1 removed").arg(droneIndex));
+    if (newDrone)
+    {
+        emit droneChanged(newDrone);
     }
+    if (failureChanged)
+    {
+        emit failureSimulationToggled(failureActive);
+    }
+    return true;
+}
+
+QVector<int> TelemetryModel::findDronesWithinRadius(double latitude, double longitude, double radiusMetres)
+{
+    QMutexLocker locker(&_mutex);
+    ensureSpatialIndex();
+    
+    QVector<int> result;
+    _spatialIndex.queryRadius(latitude, longitude, radiusMetres, result);
+    return result;
+}
+
+QVector<int> TelemetryModel::findDronesInBox(double minLatitude, double minLongitude,
+                                             double maxLatitude, double maxLongitude)
+{
+    QMutexLocker locker(&_mutex);
+    ensureSpatialIndex();
+    
+    QVector<int> result;
+    _spatialIndex.queryBox(minLatitude, minLongitude, maxLatitude, maxLongitude, result);
+    return result;
+}
+
+int TelemetryModel::findNearestDrone(double latitude, double longitude, double maxDistanceMetres)
+{
+    QMutexLocker locker(&_mutex);
+    ensureSpatialIndex();
+    return _spatialIndex.nearest(latitude, longitude, maxDistanceMetres);
+}
+
+void TelemetryModel::setSpatialIndexCellSize(double cellSize)
+{
+    QMutexLocker locker(&_mutex);
+    _spatialIndex.setCellSize(cellSize);
+    _spatialIndexDirty = true;
+    LOG_INFO(QString("Spatial index cell size set to %1 m").arg(_spatialIndex.getCellSize()));
+}
+
+void TelemetryModel::setSeparationMinima(double horizontalMetres, double verticalMetres)
+{
+    QMutexLocker locker(&_mutex);
+    _separationMonitor.setMinima(horizontalMetres, verticalMetres);
+    
+    // Cells smaller than the minimum would make every drone visit many mostly empty cells
+    if (_spatialIndex.getCellSize() < _separationMonitor.getHorizontalMinimum())
+    {
+        _spatialIndex.setCellSize(_separationMonitor.getHorizontalMinimum());
+        _spatialIndexDirty = true;
+    }
+    LOG_INFO(QString("Separation minima set to %1 m horizontal, %2 m vertical")
+             .arg(_separationMonitor.getHorizontalMinimum())
+             .arg(_separationMonitor.getVerticalMinimum()));
+}
+
+void TelemetryModel::setSeparationMonitoringEnabled(bool enabled)
+{
+    QMutexLocker locker(&_mutex);
+    
+    if (_separationMonitoringEnabled != enabled)
+    {
+        _separationMonitoringEnabled = enabled;
+        _separationMonitor.reset();
+        LOG_INFO(QString("Separation monitoring %1").arg(enabled ? "enabled" : "disabled"));
+    }
+}
+
+QVector<SeparationConflict> TelemetryModel::getActiveConflicts() const
+{
+    QMutexLocker locker(&_mutex);
+    return _separationMonitor.getConflicts();
+}
+
+quint64 TelemetryModel::getSeparationConflictCount() const
+{
+    QMutexLocker locker(&_mutex);
+    return _separationMonitor.getStartedCount();
 }
 
 void TelemetryModel::setMovementStrategy(MovementStrategy* strategy)
 {
+    QMutexLocker locker(&_mutex);
+    
     if (_currentStrategy != strategy)
     {
+        MovementStrategy* previous = _currentStrategy;
         _currentStrategy = strategy;
+        locker.unlock();
+        
+        // Shared strategies come back again and again; keep exactly one connection to the current one
+        if (previous)
+        {
+            disconnect(previous, &MovementStrategy::strategyChanged,
+                       this, &TelemetryModel::strategyChanged);
+        }
         
-        if (_currentStrategy)
+        // The lock is released, so use the parameter rather than _currentStrategy
+        if (strategy)
         {
-            connect(_currentStrategy, &MovementStrategy::strategyChanged,
+            connect(strategy, &MovementStrategy::strategyChanged,
                     this, &TelemetryModel::strategyChanged);
             
-            LOG_INFO(QString("Movement strategy changed to: %1").arg(_currentStrategy->getStrategyName()));
-            emit strategyChanged(_currentStrategy->getStrategyName());
+            LOG_INFO(QString("Movement strategy changed to: %1").arg(strategy->getStrategyName()));
+            emit strategyChanged(strategy->getStrategyName());
         }
     }
 }
 
+void TelemetryModel::setDroneStrategy(int droneIndex, MovementStrategy* strategy)
+{
+    QMutexLocker locker(&_mutex);
+    
+    if (droneIndex < 0 || droneIndex >= _fleet.size())
+    {
+        LOG_WARNING(QString("Cannot set strategy for drone slot %1: out of range").arg(droneIndex));
+        return;
+    }
+    
+    int strategyId = 0;
+    if (strategy)
+    {
+        strategyId = _droneStrategies.indexOf(strategy, 1);
+        if (strategyId < 0)
+        {
+            if (_droneStrategies.size() >= MAX_DRONE_STRATEGIES)
+            {
+                LOG_WARNING("Cannot register more per-drone movement strategies");
+                return;
+            }
+            strategyId = _droneStrategies.size();
+            _droneStrategies.append(strategy);
+        }
+    }
+    
+    _fleet.strategyIds()[droneIndex] = static_cast<quint8>(strategyId);
+}
+
+void TelemetryModel::setThreadCount(int threadCount)
+{
+    QMutexLocker locker(&_mutex);
+    
+    if (_threadCount != threadCount)
+    {
+        _threadCount = qMax(0, threadCount);
+        _executor.reset(); // Recreated with the new size on the next parallel tick
+        LOG_INFO(QString("Tick thread count set to %1").arg(_threadCount));
+    }
+}
+
+void TelemetryModel::setSeed(quint64 seed)
+{
+    QMutexLocker locker(&_mutex);
+    _rng = CounterRng(seed);
+    LOG_INFO(QString("Simulation seed set to: %1").arg(seed));
+}
+
 void TelemetryModel::startSimulation()
 {
-    if (!_simulationTimer->isActive())
+    if (!_simulationRunning)
     {
-        _simulationTimer->start();
+        _simulationRunning = true;
         LOG_INFO("Simulation started");
         emit simulationStarted();
     }
@@ -105,9 +389,9 @@ void TelemetryModel::startSimulation()
 
 void TelemetryModel::stopSimulation()
 {
-    if (_simulationTimer->isActive())
+    if (_simulationRunning)
     {
-        _simulationTimer->stop();
+        _simulationRunning = false;
         LOG_INFO("Simulation stopped");
         emit simulationStopped();
     }
@@ -115,17 +399,24 @@ void TelemetryModel::stopSimulation()
 
 void TelemetryModel::toggleFailureSimulation()
 {
-    _failureSimulationActive = !_failureSimulationActive;
-    
-    if (_drone)
     {
-        if (_failureSimulationActive)
-        {
-            _drone->simulateFailure();
-        }
-        else
+        QMutexLocker locker(&_mutex);
+        _failureSimulationActive = !_failureSimulationActive;
+        
+        if (_drone)
         {
-            _drone->resetFailure();
+            // Publish before notifying so observers read the new state
+            _drone->beginUpdate();
+            if (_failureSimulationActive)
+            {
+                _drone->simulateFailure();
+            }
+            else
+            {
+                _drone->resetFailure();
+            }
+            publishSnapshot(_drone->getPendingFields());
+            _drone->commitUpdate();
         }
     }
     
@@ -133,30 +424,373 @@ void TelemetryModel::toggleFailureSimulation()
     emit failureSimulationToggled(_failureSimulationActive);
 }
 
-void TelemetryModel::updateTelemetry()
+void TelemetryModel::updateTelemetry(double dt)
 {
+    TRACE_SCOPE("Tick", "simulation"); // Includes waiting for the lock
+    QMutexLocker locker(&_mutex);
+    
     if (!_drone || !_currentStrategy)
     {
         return;
     }
     
-    // Update drone position using current strategy
-    _currentStrategy->updatePosition(_drone);
+    qint64 tickStart = _profiler.now();
+    
+    // Coalesce everything this tick changes into a single drone notification
+    _drone->beginUpdate();
+    
+    FleetState* fleet = _drone->getFleet();
+    TickContext context;
+    context.tick = _tick;
+    context.rng = _rng;
+    context.dt = dt;
+    int droneIndex = _drone->getIndex();
+    
+    // Take the slice on this thread: it may detach the arrays from the last
+    // snapshot, which must not happen concurrently on the workers
+    FleetSlice all = fleet->slice();
+    int chunkCount = (all.count + TICK_CHUNK_SIZE - 1) / TICK_CHUNK_SIZE;
+    TickPhaseTimes phaseTimes;
+    auto runChunk = [&](int chunk) {
+        int begin = chunk * TICK_CHUNK_SIZE;
+        tickChunk(all.subSlice(begin, qMin(TICK_CHUNK_SIZE, all.count - begin)), context, droneIndex, phaseTimes);
+    };
+    
+    if (chunkCount > 1)
+    {
+        if (!_executor)
+        {
+            _executor.reset(new ParallelTickExecutor(_threadCount));
+        }
+        _executor->run(chunkCount, runChunk); // Returns once every chunk is done
+    }
+    else if (chunkCount == 1)
+    {
+        runChunk(0);
+    }
+    _drone->markChanged(TelemetryField::KINEMATICS);
+    qint64 phaseStart = _profiler.lap(TickProfiler::FLEET_UPDATE_PHASE, tickStart);
     
-    // Drain battery
-    _drone->drainBattery();
+    // The current drone drains through Drone so its low-battery signal still fires
+    _drone->drainBattery(dt);
+    qint64 drainEnd = _profiler.now();
+    _profiler.record(TickProfiler::STRATEGY_PHASE, phaseTimes.strategyNs.load(std::memory_order_relaxed));
+    _profiler.record(TickProfiler::BATTERY_PHASE,
+                     phaseTimes.batteryNs.load(std::memory_order_relaxed) + drainEnd - phaseStart);
     
-    // Emit telemetry updated signal
-    emit telemetryUpdated();
+    // Re-index the new positions on the same workers
+    _spatialIndex.update(*fleet, chunkCount > 1 ? _executor.get() : nullptr);
+    _spatialIndexDirty = false;
+    phaseStart = _profiler.lap(TickProfiler::SPATIAL_INDEX_PHASE, drainEnd);
+    
+    // Separation check over the same index; its latency counts from the new positions
+    QVector<SeparationConflict> newConflicts;
+    qint64 activeConflicts = 0;
+    qint64 detectionLatency = 0;
+    bool reportConflicts = false;
+    if (_separationMonitoringEnabled)
+    {
+        _separationMonitor.detect(*fleet, _spatialIndex, chunkCount > 1 ? _executor.get() : nullptr);
+        newConflicts = _separationMonitor.getNewConflicts();
+        activeConflicts = _separationMonitor.getConflictCount();
+        phaseStart = _profiler.lap(TickProfiler::CONFLICT_DETECTION_PHASE, drainEnd);
+        detectionLatency = phaseStart - drainEnd;
+        if (!newConflicts.isEmpty() && phaseStart - _lastConflictReportNs >= CONFLICT_REPORT_INTERVAL_NS)
+        {
+            _lastConflictReportNs = phaseStart;
+            reportConflicts = true;
+        }
+    }
+    
+    ++_tick;
+    _simulationTime += dt;
+    publishSnapshot(_drone->getPendingFields());
+    phaseStart = _profiler.lap(TickProfiler::PUBLISH_PHASE, phaseStart);
+    
+    if (_recorder)
+    {
+        TelemetrySnapshot snapshot;
+        fillSnapshot(snapshot);
+        _recorder->record(snapshot); // Queued for the recorder's thread; dropped if it falls behind
+        phaseStart = _profiler.lap(TickProfiler::RECORD_PHASE, phaseStart);
+    }
+    
+    // Emits the drone's own telemetryUpdated once for the whole tick
+    _drone->commitUpdate();
+    qint64 tickEnd = _profiler.lap(TickProfiler::SIGNAL_PHASE, phaseStart);
+    quint64 tick = _tick;
+    locker.unlock();
+    
+    if (_profiler.recordTick(tickEnd - tickStart))
+    {
+        LOG_WARNING(QString("Tick %1 overran its %2 ms budget: took %3 ms (%4 overrun(s) so far)")
+                    .arg(tick)
+                    .arg(_profiler.getTickBudget() / 1e6, 0, 'f', 3)
+                    .arg((tickEnd - tickStart) / 1e6, 0, 'f', 3)
+                    .arg(_profiler.getOverrunCount()));
+    }
+    
+    if (!newConflicts.isEmpty())
+    {
+        emit separationConflictsDetected(newConflicts, detectionLatency);
+    }
+    if (reportConflicts)
+    {
+        // One line per interval however many pairs start; receivers of the signal get them all
+        const SeparationConflict& conflict = newConflicts.first();
+        const DroneNameTable& names = DroneNameTable::getInstance();
+        LOG_WARNING(QString("Separation conflict: %1 and %2 are %3 m apart, %4 m vertically "
+                            "(%5 new, %6 active, detected in %7 ms)")
+                    .arg(names.name(conflict.firstId), names.name(conflict.secondId))
+                    .arg(conflict.horizontalDistance, 0, 'f', 1)
+                    .arg(conflict.verticalDistance, 0, 'f', 1)
+                    .arg(newConflicts.size())
+                    .arg(activeConflicts)
+                    .arg(detectionLatency / 1e6, 0, 'f', 3));
+    }
+}
+
+void TelemetryModel::loadSnapshot(const TelemetrySnapshot& snapshot)
+{
+    Drone* newDrone = nullptr;
+    bool failureChanged = false;
+    bool failureActive = false;
+    {
+        QMutexLocker locker(&_mutex);
+        
+        if (snapshot.fleet.isEmpty())
+        {
+            return;
+        }
+        
+        _fleet = snapshot.fleet; // Shares the arrays; the first write detaches them
+        _tick = snapshot.tick;
+        _simulationTime = snapshot.simulationTime;
+        
+        // Keep the current drone if the recording has its slot
+        if (!_drone || _drone->getFleet() != &_fleet || _drone->getIndex() >= _fleet.size())
+        {
+            if (_drone && _drone->parent() == _dronePool)
+            {
+                _dronePool->release(_drone);
+            }
+            newDrone = _dronePool->acquire(&_fleet, 0);
+            _drone = newDrone;
+        }
+        
+        failureActive = _fleet.failureModes()[_drone->getIndex()] != 0;
+        failureChanged = failureActive != _failureSimulationActive;
+        _failureSimulationActive = failureActive;
+        _spatialIndexDirty = true;
+        publishSnapshot(TelemetryField::ALL);
+    }
+    
+    if (newDrone)
+    {
+        emit droneChanged(newDrone);
+    }
+    if (failureChanged)
+    {
+        emit failureSimulationToggled(failureActive);
+    }
+}
+
+TelemetrySnapshotBuffer* TelemetryModel::openSnapshotBuffer()
+{
+    QMutexLocker locker(&_mutex);
+    
+    _snapshotBuffers.emplace_back(new TelemetrySnapshotBuffer());
+    TelemetrySnapshotBuffer* buffer = _snapshotBuffers.back().get();
+    
+    // Seed the buffer with the current state so the consumer never sees an empty fleet
+    if (_drone)
+    {
+        fillSnapshot(buffer->beginWrite());
+        buffer->publish(TelemetryField::ALL);
+    }
+    return buffer;
+}
+
+void TelemetryModel::closeSnapshotBuffer(TelemetrySnapshotBuffer* buffer)
+{
+    QMutexLocker locker(&_mutex);
+    
+    for (auto it = _snapshotBuffers.begin(); it != _snapshotBuffers.end(); ++it)
+    {
+        if (it->get() == buffer)
+        {
+            _snapshotBuffers.erase(it);
+            return;
+        }
+    }
+}
+
+bool TelemetryModel::startRecording(const QString& path)
+{
+    QMutexLocker locker(&_mutex);
+    
+    if (_recorder)
+    {
+        LOG_WARNING("Cannot start recording: a recording is already running");
+        return false;
+    }
+    
+    std::unique_ptr<TelemetryRecorder> recorder(new TelemetryRecorder());
+    if (!recorder->open(path))
+    {
+        return false;
+    }
+    
+    // The first frame is the state the recording starts from
+    if (_drone)
+    {
+        TelemetrySnapshot snapshot;
+        fillSnapshot(snapshot);
+        recorder->record(snapshot);
+    }
+    _recorder = std::move(recorder);
+    return true;
 }
 
-void TelemetryModel::onDroneTelemetryUpdated()
+void TelemetryModel::stopRecording()
 {
-    emit telemetryUpdated();
+    std::unique_ptr<TelemetryRecorder> recorder;
+    {
+        QMutexLocker locker(&_mutex);
+        recorder = std::move(_recorder);
+    }
+    
+    // Closing waits for the writer to drain, so keep the tick out of it
+    if (recorder)
+    {
+        recorder->close();
+    }
+}
+
+bool TelemetryModel::isRecording() const
+{
+    QMutexLocker locker(&_mutex);
+    return _recorder != nullptr;
+}
+
+void TelemetryModel::deliverTelemetryUpdate()
+{
+    quint32 changedFields = _notifyFields.exchange(TelemetryField::NONE, std::memory_order_acq_rel);
+    if (changedFields != TelemetryField::NONE)
+    {
+        emit telemetryUpdated(changedFields);
+    }
 }
 
 void TelemetryModel::initializeDefaultStrategy()
 {
     // Set default strategy to hover
-    setMovementStrategy(new HoverStrategy(this));
+    setMovementStrategy(StrategyFactory::getSharedStrategy(StrategyFactory::HOVER_STRATEGY));
+}
+
+void TelemetryModel::ensureSpatialIndex()
+{
+    if (_spatialIndexDirty)
+    {
+        _spatialIndex.update(_drone ? *_drone->getFleet() : _fleet);
+        _spatialIndexDirty = false;
+    }
+}
+
+void TelemetryModel::drainBatteries(const FleetSlice& slice, double dt)
+{
+    for (int i = 0; i < slice.count; ++i)
+    {
+        // Faster drain in failure mode
+        int drainAmount = Drone::accumulateDrain(slice.failureModes[i], dt, slice.batteryDrains[i]);
+        slice.batteries[i] = qMax(0, slice.batteries[i] - drainAmount);
+    }
+}
+
+void TelemetryModel::tickChunk(const FleetSlice& chunk, const TickContext& context, int droneIndex,
+                               TickPhaseTimes& times) const
+{
+    qint64 strategyStart = _profiler.now();
+    
+    // Dispatch each run of drones sharing a strategy as one batched call
+    int runStart = 0;
+    for (int i = 1; i <= chunk.count; ++i)
+    {
+        if (i == chunk.count || chunk.strategyIds[i] != chunk.strategyIds[runStart])
+        {
+            if (MovementStrategy* strategy = strategyFor(chunk.strategyIds[runStart]))
+            {
+                strategy->updatePositions(chunk.subSlice(runStart, i - runStart), context);
+            }
+            runStart = i;
+        }
+    }
+    
+    // Drain batteries in bulk, skipping the current drone
+    qint64 drainStart = _profiler.now();
+    int local = droneIndex - chunk.begin;
+    if (local >= 0 && local < chunk.count)
+    {
+        drainBatteries(chunk.subSlice(0, local), context.dt);
+        drainBatteries(chunk.subSlice(local + 1, chunk.count - local - 1), context.dt);
+    }
+    else
+    {
+        drainBatteries(chunk, context.dt);
+    }
+    
+    qint64 drainEnd = _profiler.now();
+    times.strategyNs.fetch_add(drainStart - strategyStart, std::memory_order_relaxed);
+    times.batteryNs.fetch_add(drainEnd - drainStart, std::memory_order_relaxed);
+    
+    TraceRecorder& tracer = TraceRecorder::getInstance();
+    tracer.addEvent("Strategy", "worker", strategyStart, drainStart, "firstDrone", chunk.begin);
+    tracer.addEvent("Battery drain", "worker", drainStart, drainEnd, "firstDrone", chunk.begin);
+}
+
+MovementStrategy* TelemetryModel::strategyFor(quint8 strategyId) const
+{
+    if (strategyId > 0 && strategyId < _droneStrategies.size())
+    {
+        return _droneStrategies[strategyId];
+    }
+    return _currentStrategy;
+}
+
+void TelemetryModel::publishSnapshot(quint32 changedFields)
+{
+    if (!_drone)
+    {
+        return;
+    }
+    
+    for (const auto& buffer : _snapshotBuffers)
+    {
+        fillSnapshot(buffer->beginWrite());
+        buffer->publish(changedFields);
+    }
+    
+    notifyTelemetryUpdated(changedFields);
+}
+
+void TelemetryModel::fillSnapshot(TelemetrySnapshot& snapshot) const
+{
+    snapshot.tick = _tick;
+    snapshot.simulationTime = _simulationTime;
+    snapshot.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    snapshot.fleet = *_drone->getFleet(); // Shares the arrays until the next tick writes them
+}
+
+void TelemetryModel::notifyTelemetryUpdated(quint32 changedFields)
+{
+    if (changedFields == TelemetryField::NONE)
+    {
+        return;
+    }
+    
+    // Only the first change after a delivery queues an event; later ones ride along
+    if (_notifyFields.fetch_or(changedFields, std::memory_order_acq_rel) == TelemetryField::NONE)
+    {
+        QMetaObject::invokeMethod(this, &TelemetryModel::deliverTelemetryUpdate, Qt::QueuedConnection);
+    }
 }
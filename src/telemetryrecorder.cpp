@@ -0,0 +1,541 @@
+#include "telemetryrecorder.h"
+#include "logger.h"
+#include "tracerecorder.h"
+#include <QByteArray>
+#include <QDateTime>
+#include <QThread>
+#include <algorithm>
+#include <cstring>
+
+using namespace TelemetryRecording;
+
+namespace
+{
+constexpr unsigned long WRITER_POLL_MS = 2;         // Writer sleep when the queue is empty
+constexpr quint64 WINDOW_BYTES = 64ull << 20;       // Smallest mapped region
+constexpr quint64 GROWTH_BYTES = 256ull << 20;      // File growth step (trimmed on close)
+
+/**
+ * @brief Delta-encode one column of quantised values against the previous frame
+ */
+template <typename Quantize>
+quint8* encodeColumn(quint8* out, qint32* previous, int count, Quantize quantizeSlot)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        qint32 value = quantizeSlot(i);
+        out = writeDelta(out, value, previous[i]);
+        previous[i] = value;
+    }
+    return out;
+}
+}
+
+TelemetryRecorder::TelemetryRecorder()
+    : _header(nullptr)
+    , _window(nullptr)
+    , _windowOffset(0)
+    , _windowBytes(0)
+    , _chunkOffset(0)
+    , _writeOffset(0)
+    , _chunkFrames(DEFAULT_CHUNK_FRAMES)
+    , _failed(false)
+    , _warnedInvalidId(false)
+    , _queueMask(0)
+    , _queueHead(0)
+    , _queueTail(0)
+    , _writerThread(nullptr)
+    , _stopWriter(false)
+    , _recordedFrames(0)
+    , _droppedFrames(0)
+    , _bytesWritten(0)
+{
+}
+
+TelemetryRecorder::~TelemetryRecorder()
+{
+    close();
+}
+
+bool TelemetryRecorder::open(const QString& path, int chunkFrames, int queueCapacity)
+{
+    if (isOpen())
+    {
+        LOG_WARNING(QString("Recorder already writing %1").arg(_file.fileName()));
+        return false;
+    }
+
+    _file.setFileName(path);
+    if (!_file.open(QIODevice::ReadWrite | QIODevice::Truncate) || !_file.resize(GROWTH_BYTES))
+    {
+        LOG_ERROR(QString("Failed to create recording %1: %2").arg(path, _file.errorString()));
+        _file.close();
+        return false;
+    }
+
+    // The header stays mapped so each closed chunk can be published in it
+    _header = reinterpret_cast<FileHeader*>(_file.map(0, sizeof(FileHeader)));
+    if (!_header)
+    {
+        LOG_ERROR(QString("Failed to map recording %1: %2").arg(path, _file.errorString()));
+        _file.close();
+        return false;
+    }
+    std::memcpy(_header->magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    _header->version = FORMAT_VERSION;
+    _header->headerBytes = sizeof(FileHeader);
+    _header->createdMs = QDateTime::currentMSecsSinceEpoch();
+    _header->dataEnd = sizeof(FileHeader);
+    _header->indexOffset = 0;
+    _header->indexCount = 0;
+
+    _window = nullptr;
+    _windowOffset = 0;
+    _windowBytes = 0;
+    _chunkOffset = 0;
+    _writeOffset = sizeof(FileHeader);
+    _chunkFrames = qMax(1, chunkFrames);
+    _chunkIds.clear();
+    _slotIds.clear();
+    _slotOfId.clear();
+    _previous.clear();
+    _index.clear();
+    _failed = false;
+    _warnedInvalidId = false;
+
+    size_t size = 1;
+    while (size < static_cast<size_t>(qMax(queueCapacity, 2)))
+    {
+        size <<= 1;
+    }
+    _queue.resize(static_cast<int>(size));
+    _queueMask = size - 1;
+    _queueHead.store(0, std::memory_order_relaxed);
+    _queueTail.store(0, std::memory_order_relaxed);
+    _recordedFrames.store(0, std::memory_order_relaxed);
+    _droppedFrames.store(0, std::memory_order_relaxed);
+    _bytesWritten.store(0, std::memory_order_relaxed);
+
+    _stopWriter.store(false, std::memory_order_release);
+    _writerThread = QThread::create([this]() { writerLoop(); });
+    _writerThread->setObjectName("RecorderWriterThread");
+    _writerThread->start();
+
+    LOG_INFO(QString("Recording telemetry to %1 (%2 frames per chunk)").arg(path).arg(_chunkFrames));
+    return true;
+}
+
+void TelemetryRecorder::close()
+{
+    if (!_writerThread)
+    {
+        return;
+    }
+
+    // The writer drains the queue before it exits
+    _stopWriter.store(true, std::memory_order_release);
+    _writerThread->wait();
+    delete _writerThread;
+    _writerThread = nullptr;
+
+    if (_chunkOffset != 0)
+    {
+        endChunk();
+    }
+    if (_window)
+    {
+        _file.unmap(_window);
+        _window = nullptr;
+    }
+
+    // Trim the preallocated tail and append the index for O(log n) seeking
+    quint64 dataEnd = _header->dataEnd;
+    _file.resize(static_cast<qint64>(dataEnd));
+    if (!_failed)
+    {
+        qint64 indexBytes = static_cast<qint64>(_index.size()) * sizeof(ChunkIndexEntry);
+        if (_file.seek(static_cast<qint64>(dataEnd)) &&
+            _file.write(reinterpret_cast<const char*>(_index.constData()), indexBytes) == indexBytes)
+        {
+            _header->indexOffset = dataEnd;
+            _header->indexCount = static_cast<quint64>(_index.size());
+        }
+        else
+        {
+            LOG_ERROR(QString("Failed to write recording index to %1: %2").arg(_file.fileName(), _file.errorString()));
+        }
+    }
+    _file.unmap(reinterpret_cast<uchar*>(_header));
+    _header = nullptr;
+    _file.close();
+    _queue.clear();
+
+    LOG_INFO(QString("Recording %1 closed: %2 frames in %3 chunks, %4 MB, %5 frames dropped")
+             .arg(_file.fileName())
+             .arg(getRecordedFrames())
+             .arg(_index.size())
+             .arg(dataEnd / double(1 << 20), 0, 'f', 1)
+             .arg(getDroppedFrames()));
+}
+
+bool TelemetryRecorder::record(const TelemetrySnapshot& snapshot)
+{
+    size_t head = _queueHead.load(std::memory_order_relaxed);
+    if (head - _queueTail.load(std::memory_order_acquire) > _queueMask)
+    {
+        _droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    _queue[static_cast<int>(head & _queueMask)] = snapshot; // Shares the fleet arrays
+    _queueHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void TelemetryRecorder::writerLoop()
+{
+    while (true)
+    {
+        size_t tail = _queueTail.load(std::memory_order_relaxed);
+        if (tail == _queueHead.load(std::memory_order_acquire))
+        {
+            if (_stopWriter.load(std::memory_order_acquire))
+            {
+                break;
+            }
+            QThread::msleep(WRITER_POLL_MS);
+            continue;
+        }
+
+        // Move out so the slot stops holding the fleet arrays while they are encoded
+        TelemetrySnapshot snapshot = std::move(_queue[static_cast<int>(tail & _queueMask)]);
+        _queueTail.store(tail + 1, std::memory_order_release);
+        writeFrame(snapshot);
+    }
+}
+
+void TelemetryRecorder::writeFrame(const TelemetrySnapshot& snapshot)
+{
+    TRACE_SCOPE("Encode frame", "recorder", "tick", static_cast<qint64>(snapshot.tick));
+
+    if (_failed)
+    {
+        _droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const FleetState& fleet = snapshot.fleet;
+    int count = fleet.size();
+
+    // A drone without an ID (e.g. spawned while the name table was full) cannot be
+    // replayed; drop the frame before it touches the slot tables
+    if (std::find(fleet.ids(), fleet.ids() + count, DroneNameTable::INVALID_DRONE_ID) != fleet.ids() + count)
+    {
+        if (!_warnedInvalidId)
+        {
+            LOG_WARNING("Dropping recorded frames with drones that have no ID");
+            _warnedInvalidId = true;
+        }
+        _droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // A new chunk starts with a keyframe; drones changing slots only add a slot change block to the frame
+    if (_chunkOffset != 0 &&
+        reinterpret_cast<const ChunkHeader*>(at(_chunkOffset))->frameCount >= static_cast<quint32>(_chunkFrames))
+    {
+        endChunk();
+    }
+    quint64 slotChangeBytes = 0;
+    if (_chunkOffset == 0)
+    {
+        if (!beginChunk(fleet))
+        {
+            return;
+        }
+    }
+    else
+    {
+        slotChangeBytes = diffSlots(fleet);
+    }
+
+    // Worst case for the frame, so encoding can write straight into the mapping
+    if (!reserve(sizeof(FrameHeader) + slotChangeBytes + static_cast<quint64>(count) * COLUMN_COUNT * MAX_VARINT_BYTES +
+                 HEADER_ALIGNMENT))
+    {
+        return;
+    }
+
+    quint8* payload = at(_writeOffset + sizeof(FrameHeader));
+    quint8* out = slotChangeBytes != 0 ? writeSlotChanges(payload, count) : payload;
+    qint32* previous = _previous.data();
+
+    const double* latitudes = fleet.latitudes();
+    const double* longitudes = fleet.longitudes();
+    const double* altitudes = fleet.altitudes();
+    const double* headings = fleet.headings();
+    const double* speeds = fleet.speeds();
+    const int* batteries = fleet.batteries();
+    const GPSFixStatus* gpsFixStatuses = fleet.gpsFixStatuses();
+    const quint8* failureModes = fleet.failureModes();
+
+    out = encodeColumn(out, previous + LATITUDE_COLUMN * count, count,
+                       [&](int i) { return quantize(latitudes[i], DEGREE_SCALE); });
+    out = encodeColumn(out, previous + LONGITUDE_COLUMN * count, count,
+                       [&](int i) { return quantize(longitudes[i], DEGREE_SCALE); });
+    out = encodeColumn(out, previous + ALTITUDE_COLUMN * count, count,
+                       [&](int i) { return quantize(altitudes[i], METRE_SCALE); });
+    out = encodeColumn(out, previous + HEADING_COLUMN * count, count,
+                       [&](int i) { return quantize(headings[i], HEADING_SCALE); });
+    out = encodeColumn(out, previous + SPEED_COLUMN * count, count,
+                       [&](int i) { return quantize(speeds[i], METRE_SCALE); });
+    out = encodeColumn(out, previous + BATTERY_COLUMN * count, count,
+                       [&](int i) { return static_cast<qint32>(batteries[i]); });
+    out = encodeColumn(out, previous + GPS_FIX_COLUMN * count, count,
+                       [&](int i) { return static_cast<qint32>(gpsFixStatuses[i]); });
+    out = encodeColumn(out, previous + FAILURE_MODE_COLUMN * count, count,
+                       [&](int i) { return static_cast<qint32>(failureModes[i]); });
+
+    // Pad so the next header is aligned
+    quint64 end = alignOffset(_writeOffset + sizeof(FrameHeader) + (out - payload));
+    std::memset(out, 0, at(end) - out);
+
+    FrameHeader* frame = reinterpret_cast<FrameHeader*>(at(_writeOffset));
+    frame->tick = snapshot.tick;
+    frame->simulationTime = snapshot.simulationTime;
+    frame->timestampMs = snapshot.timestampMs;
+    frame->payloadBytes = static_cast<quint32>(end - _writeOffset - sizeof(FrameHeader));
+    frame->slotChangeBytes = static_cast<quint32>(slotChangeBytes);
+    _writeOffset = end;
+
+    ChunkHeader* chunk = reinterpret_cast<ChunkHeader*>(at(_chunkOffset));
+    if (chunk->frameCount == 0)
+    {
+        chunk->firstTick = snapshot.tick;
+        chunk->firstSimulationTime = snapshot.simulationTime;
+    }
+    chunk->lastTick = snapshot.tick;
+    chunk->lastSimulationTime = snapshot.simulationTime;
+    chunk->frameCount += 1;
+    chunk->chunkBytes = _writeOffset - _chunkOffset;
+
+    _recordedFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool TelemetryRecorder::beginChunk(const FleetState& fleet)
+{
+    int count = fleet.size();
+    const DroneId* ids = fleet.ids();
+
+    // Readers take the IDs before firstNewId from the chunk before
+    int firstNewId = 0;
+    int common = qMin(count, static_cast<int>(_chunkIds.size()));
+    while (firstNewId < common && _chunkIds[firstNewId] == ids[firstNewId])
+    {
+        ++firstNewId;
+    }
+
+    QVector<QByteArray> newIds;
+    quint64 idBytes = 0;
+    for (int i = firstNewId; i < count; ++i)
+    {
+        newIds.append(fleet.name(i).toUtf8().left(0xFFFF));
+        idBytes += sizeof(quint16) + newIds.last().size();
+    }
+
+    _chunkOffset = _writeOffset;
+    if (!reserve(sizeof(ChunkHeader) + idBytes + HEADER_ALIGNMENT))
+    {
+        _chunkOffset = 0;
+        return false;
+    }
+
+    ChunkHeader* chunk = reinterpret_cast<ChunkHeader*>(at(_chunkOffset));
+    std::memset(chunk, 0, sizeof(ChunkHeader));
+    chunk->magic = CHUNK_MAGIC;
+    chunk->droneCount = static_cast<quint32>(count);
+    chunk->newIdCount = static_cast<quint32>(newIds.size());
+
+    uchar* out = at(_chunkOffset + sizeof(ChunkHeader));
+    for (const QByteArray& id : newIds)
+    {
+        quint16 length = static_cast<quint16>(id.size());
+        std::memcpy(out, &length, sizeof(length));
+        std::memcpy(out + sizeof(length), id.constData(), length);
+        out += sizeof(length) + length;
+    }
+    quint64 end = alignOffset(_writeOffset + sizeof(ChunkHeader) + idBytes);
+    std::memset(out, 0, at(end) - out);
+    _writeOffset = end;
+    chunk->chunkBytes = _writeOffset - _chunkOffset;
+
+    _chunkIds.resize(count);
+    _slotIds.resize(count);
+    for (int i = 0; i < count; ++i)
+    {
+        _chunkIds[i] = ids[i];
+        setSlotId(i, ids[i]);
+    }
+    _previous.fill(0, count * COLUMN_COUNT); // Keyframe: deltas against zero
+    return true;
+}
+
+quint64 TelemetryRecorder::diffSlots(const FleetState& fleet)
+{
+    int count = fleet.size();
+    int previousCount = _slotIds.size();
+    const DroneId* ids = fleet.ids();
+
+    _slotChanges.clear();
+    _newIds.clear();
+    for (int i = 0; i < count; ++i)
+    {
+        DroneId id = ids[i];
+        if (i < previousCount && _slotIds[i] == id)
+        {
+            continue;
+        }
+        int slot = id < static_cast<DroneId>(_slotOfId.size()) ? _slotOfId[id] : -1;
+        SlotChange change = {static_cast<quint32>(i), NEW_DRONE};
+        if (slot >= 0 && slot < previousCount && _slotIds[slot] == id)
+        {
+            change.source = static_cast<quint32>(slot);
+        }
+        else
+        {
+            _newIds.append(fleet.name(i).toUtf8().left(0xFFFF));
+        }
+        _slotChanges.append(change);
+    }
+    if (_slotChanges.isEmpty() && count == previousCount)
+    {
+        return 0;
+    }
+
+    // Move each drone's previous values to its new slot; new drones start from zero
+    int kept = qMin(count, previousCount);
+    _remapped.resize(count * COLUMN_COUNT);
+    for (int column = 0; column < COLUMN_COUNT; ++column)
+    {
+        const qint32* from = _previous.constData() + column * previousCount;
+        qint32* to = _remapped.data() + column * count;
+        std::memcpy(to, from, kept * sizeof(qint32));
+        for (const SlotChange& change : _slotChanges)
+        {
+            to[change.slot] = change.source == NEW_DRONE ? 0 : from[change.source];
+        }
+    }
+    _previous.swap(_remapped);
+
+    _slotIds.resize(count);
+    for (const SlotChange& change : _slotChanges)
+    {
+        setSlotId(static_cast<int>(change.slot), ids[change.slot]);
+    }
+
+    quint64 bytes = sizeof(SlotChangeHeader) + static_cast<quint64>(_slotChanges.size()) * sizeof(SlotChange);
+    for (const QByteArray& id : _newIds)
+    {
+        bytes += sizeof(quint16) + id.size();
+    }
+    return bytes;
+}
+
+quint8* TelemetryRecorder::writeSlotChanges(quint8* out, int droneCount) const
+{
+    SlotChangeHeader header;
+    header.droneCount = static_cast<quint32>(droneCount);
+    header.changeCount = static_cast<quint32>(_slotChanges.size());
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, _slotChanges.constData(), _slotChanges.size() * sizeof(SlotChange));
+    out += _slotChanges.size() * sizeof(SlotChange);
+    for (const QByteArray& id : _newIds)
+    {
+        quint16 length = static_cast<quint16>(id.size());
+        std::memcpy(out, &length, sizeof(length));
+        std::memcpy(out + sizeof(length), id.constData(), length);
+        out += sizeof(length) + length;
+    }
+    return out;
+}
+
+void TelemetryRecorder::setSlotId(int slot, DroneId id)
+{
+    _slotIds[slot] = id;
+    if (id == DroneNameTable::INVALID_DRONE_ID)
+    {
+        return;
+    }
+    if (id >= static_cast<DroneId>(_slotOfId.size()))
+    {
+        _slotOfId.resize(static_cast<int>(id) + 1, -1);
+    }
+    _slotOfId[static_cast<int>(id)] = slot;
+}
+
+void TelemetryRecorder::endChunk()
+{
+    const ChunkHeader* chunk = reinterpret_cast<const ChunkHeader*>(at(_chunkOffset));
+    if (chunk->frameCount > 0)
+    {
+        ChunkIndexEntry entry;
+        entry.offset = _chunkOffset;
+        entry.firstTick = chunk->firstTick;
+        entry.firstSimulationTime = chunk->firstSimulationTime;
+        entry.lastSimulationTime = chunk->lastSimulationTime;
+        entry.frameCount = chunk->frameCount;
+        entry.droneCount = chunk->droneCount;
+        _index.append(entry);
+
+        // Mapped pages outlive a crash of the process, so the file is readable up to here
+        _header->dataEnd = _writeOffset;
+        _bytesWritten.store(_writeOffset, std::memory_order_relaxed);
+    }
+    else
+    {
+        _writeOffset = _chunkOffset; // Discard an empty chunk
+    }
+    _chunkOffset = 0;
+}
+
+bool TelemetryRecorder::reserve(quint64 bytes)
+{
+    quint64 end = _writeOffset + bytes;
+    if (_window && end <= _windowOffset + _windowBytes)
+    {
+        return true;
+    }
+
+    if (_window)
+    {
+        _file.unmap(_window);
+        _window = nullptr;
+    }
+
+    quint64 start = _chunkOffset != 0 ? _chunkOffset : _writeOffset;
+    quint64 windowBytes = qMax(WINDOW_BYTES, 2 * (end - start));
+    quint64 fileBytes = ((start + windowBytes + GROWTH_BYTES - 1) / GROWTH_BYTES) * GROWTH_BYTES;
+    if (static_cast<quint64>(_file.size()) < fileBytes && !_file.resize(static_cast<qint64>(fileBytes)))
+    {
+        fail(QString("Failed to grow recording %1: %2").arg(_file.fileName(), _file.errorString()));
+        return false;
+    }
+
+    _window = _file.map(static_cast<qint64>(start), static_cast<qint64>(windowBytes));
+    if (!_window)
+    {
+        fail(QString("Failed to map recording %1: %2").arg(_file.fileName(), _file.errorString()));
+        return false;
+    }
+    _windowOffset = start;
+    _windowBytes = windowBytes;
+    return true;
+}
+
+void TelemetryRecorder::fail(const QString& message)
+{
+    LOG_ERROR(message);
+    _failed = true;
+    _chunkOffset = 0; // The open chunk is lost; dataEnd still marks the last complete one
+    _writeOffset = _header->dataEnd;
+}
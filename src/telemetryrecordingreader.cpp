@@ -0,0 +1,553 @@
+#include "telemetryrecordingreader.h"
+#include "logger.h"
+#include <algorithm>
+
+using namespace TelemetryRecording;
+
+TelemetryRecordingReader::TelemetryRecordingReader()
+    : _data(nullptr)
+    , _size(0)
+    , _frameCount(0)
+    , _idsChunk(-1)
+    , _baseChunk(-1)
+    , _slotIdsChanged(false)
+    , _chunk(-1)
+    , _frame(-1)
+    , _droneCount(0)
+{
+}
+
+TelemetryRecordingReader::~TelemetryRecordingReader()
+{
+    close();
+}
+
+bool TelemetryRecordingReader::open(const QString& path)
+{
+    close();
+    _errorString.clear();
+
+    _file.setFileName(path);
+    if (!_file.open(QIODevice::ReadOnly))
+    {
+        _errorString = _file.errorString();
+        return false;
+    }
+    _size = static_cast<quint64>(_file.size());
+    _data = _size >= sizeof(FileHeader) ? _file.map(0, _file.size()) : nullptr;
+    if (!_data)
+    {
+        _errorString = _size < sizeof(FileHeader) ? QString("File is too small") : _file.errorString();
+        close();
+        return false;
+    }
+
+    FileHeader header = readStruct<FileHeader>(0);
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header.version < MIN_FORMAT_VERSION ||
+        header.version > FORMAT_VERSION)
+    {
+        _errorString = "Not a telemetry recording, or an unsupported version";
+        close();
+        return false;
+    }
+
+    if (!loadIndex() || !loadIdBases())
+    {
+        close();
+        return false;
+    }
+
+    _firstFrames.reserve(_chunks.size());
+    _frameCount = 0;
+    for (const ChunkIndexEntry& entry : _chunks)
+    {
+        _firstFrames.append(_frameCount);
+        _frameCount += entry.frameCount;
+    }
+
+    LOG_INFO(QString("Opened recording %1: %2 frames in %3 chunks, %4 s to %5 s")
+             .arg(path)
+             .arg(_frameCount)
+             .arg(_chunks.size())
+             .arg(getStartTime(), 0, 'f', 1)
+             .arg(getEndTime(), 0, 'f', 1));
+    return true;
+}
+
+void TelemetryRecordingReader::close()
+{
+    if (_data)
+    {
+        _file.unmap(const_cast<uchar*>(_data));
+        _data = nullptr;
+    }
+    _file.close();
+    _size = 0;
+    _chunks.clear();
+    _firstFrames.clear();
+    _frameCount = 0;
+    _idBases.clear();
+    _idsChunk = -1;
+    _chunkIds.clear();
+    _baseChunk = -1;
+    _baseIds.clear();
+    _slotIds.clear();
+    _slotIdsChanged = false;
+    _chunk = -1;
+    _frame = -1;
+    _droneCount = 0;
+    _frameOffsets.clear();
+    _frameSlotChanges.clear();
+    _values.clear();
+    _remapped.clear();
+    _fleet.clear();
+}
+
+double TelemetryRecordingReader::getStartTime() const
+{
+    return _chunks.isEmpty() ? 0.0 : _chunks.first().firstSimulationTime;
+}
+
+double TelemetryRecordingReader::getEndTime() const
+{
+    return _chunks.isEmpty() ? 0.0 : _chunks.last().lastSimulationTime;
+}
+
+quint64 TelemetryRecordingReader::findFrame(double simulationTime) const
+{
+    if (_chunks.isEmpty())
+    {
+        return 0;
+    }
+
+    // Last chunk starting at or before the time
+    auto it = std::upper_bound(_chunks.constBegin(), _chunks.constEnd(), simulationTime,
+                               [](double time, const ChunkIndexEntry& entry) {
+                                   return time < entry.firstSimulationTime;
+                               });
+    int chunk = qMax(0, static_cast<int>(it - _chunks.constBegin()) - 1);
+    const ChunkIndexEntry& entry = _chunks[chunk];
+
+    // Hop the chunk's frame headers; the payloads are never touched
+    quint64 offset = framesOffset(entry);
+    quint64 chunkEnd = entry.offset + readStruct<ChunkHeader>(entry.offset).chunkBytes;
+    quint32 local = 0;
+    for (quint32 frame = 0; offset != 0 && frame < entry.frameCount && offset + sizeof(FrameHeader) <= chunkEnd; ++frame)
+    {
+        FrameHeader header = readStruct<FrameHeader>(offset);
+        if (header.simulationTime > simulationTime)
+        {
+            break;
+        }
+        local = frame;
+        offset += sizeof(FrameHeader) + header.payloadBytes;
+    }
+    return _firstFrames[chunk] + local;
+}
+
+bool TelemetryRecordingReader::readFrame(quint64 frame, TelemetrySnapshot& snapshot)
+{
+    if (frame >= _frameCount)
+    {
+        return false;
+    }
+
+    int chunk = static_cast<int>(std::upper_bound(_firstFrames.constBegin(), _firstFrames.constEnd(), frame) -
+                                 _firstFrames.constBegin()) - 1;
+    int local = static_cast<int>(frame - _firstFrames[chunk]);
+    if (chunk != _chunk && !enterChunk(chunk))
+    {
+        return false;
+    }
+
+    // Step from the frame we hold, or restart from the keyframe when that is shorter or when
+    // stepping back would undo slot changes (the drones they replaced are not in the frame)
+    if (_frame > local)
+    {
+        bool restart = local + 1 < _frame - local;
+        for (int i = local + 1; !restart && i <= _frame; ++i)
+        {
+            restart = _frameSlotChanges[i] != 0;
+        }
+        if (restart)
+        {
+            restartChunk();
+        }
+    }
+    while (_frame < local)
+    {
+        if (!applyFrame(_frame + 1, 1))
+        {
+            return false;
+        }
+        ++_frame;
+    }
+    while (_frame > local)
+    {
+        if (!applyFrame(_frame, -1))
+        {
+            return false;
+        }
+        --_frame;
+    }
+
+    // Dequantise into the fleet; writing detaches it from snapshots handed out earlier
+    int count = _droneCount;
+    if (_fleet.size() != count || _slotIdsChanged)
+    {
+        if (_fleet.size() != count)
+        {
+            _fleet.clear();
+            _fleet.addDrones(count);
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            DroneId id = _slotIds[i];
+            if (id == DroneNameTable::INVALID_DRONE_ID)
+            {
+                id = DroneNameTable::getInstance().intern(QString("DRONE-%1").arg(i + 1, 3, 10, QChar('0')));
+            }
+            _fleet.setId(i, id);
+        }
+        _slotIdsChanged = false;
+    }
+    const qint32* values = _values.constData();
+    double* latitudes = _fleet.latitudes();
+    double* longitudes = _fleet.longitudes();
+    double* altitudes = _fleet.altitudes();
+    double* headings = _fleet.headings();
+    double* speeds = _fleet.speeds();
+    int* batteries = _fleet.batteries();
+    GPSFixStatus* gpsFixStatuses = _fleet.gpsFixStatuses();
+    quint8* failureModes = _fleet.failureModes();
+    for (int i = 0; i < count; ++i)
+    {
+        latitudes[i] = values[LATITUDE_COLUMN * count + i] / DEGREE_SCALE;
+        longitudes[i] = values[LONGITUDE_COLUMN * count + i] / DEGREE_SCALE;
+        altitudes[i] = values[ALTITUDE_COLUMN * count + i] / METRE_SCALE;
+        headings[i] = values[HEADING_COLUMN * count + i] / HEADING_SCALE;
+        speeds[i] = values[SPEED_COLUMN * count + i] / METRE_SCALE;
+        batteries[i] = values[BATTERY_COLUMN * count + i];
+        gpsFixStatuses[i] = static_cast<GPSFixStatus>(values[GPS_FIX_COLUMN * count + i]);
+        failureModes[i] = static_cast<quint8>(values[FAILURE_MODE_COLUMN * count + i]);
+    }
+
+    FrameHeader header = readStruct<FrameHeader>(_frameOffsets[local]);
+    snapshot.tick = header.tick;
+    snapshot.simulationTime = header.simulationTime;
+    snapshot.timestampMs = header.timestampMs;
+    snapshot.fleet = _fleet;
+    return true;
+}
+
+bool TelemetryRecordingReader::loadIndex()
+{
+    FileHeader header = readStruct<FileHeader>(0);
+
+    // Written on close: copy it out, it is small
+    if (header.indexOffset != 0 && header.indexOffset <= _size &&
+        header.indexCount <= (_size - header.indexOffset) / sizeof(ChunkIndexEntry))
+    {
+        _chunks.resize(static_cast<int>(header.indexCount));
+        std::memcpy(_chunks.data(), _data + header.indexOffset, header.indexCount * sizeof(ChunkIndexEntry));
+        return true;
+    }
+
+    // Recording was cut short: walk chunk headers up to the last complete chunk
+    quint64 end = qMin<quint64>(header.dataEnd, _size);
+    quint64 offset = header.headerBytes;
+    while (offset + sizeof(ChunkHeader) <= end)
+    {
+        ChunkHeader chunk = readStruct<ChunkHeader>(offset);
+        if (chunk.magic != CHUNK_MAGIC || chunk.chunkBytes < sizeof(ChunkHeader) || chunk.chunkBytes > end - offset)
+        {
+            break;
+        }
+        ChunkIndexEntry entry;
+        entry.offset = offset;
+        entry.firstTick = chunk.firstTick;
+        entry.firstSimulationTime = chunk.firstSimulationTime;
+        entry.lastSimulationTime = chunk.lastSimulationTime;
+        entry.frameCount = chunk.frameCount;
+        entry.droneCount = chunk.droneCount;
+        _chunks.append(entry);
+        offset += chunk.chunkBytes;
+    }
+    LOG_WARNING(QString("Recording %1 was not closed cleanly; recovered %2 chunks")
+                .arg(_file.fileName())
+                .arg(_chunks.size()));
+    return true;
+}
+
+bool TelemetryRecordingReader::loadIdBases()
+{
+    _idBases.resize(_chunks.size());
+    for (int chunk = 0; chunk < _chunks.size(); ++chunk)
+    {
+        if (_chunks[chunk].offset + sizeof(ChunkHeader) > _size)
+        {
+            _errorString = "Chunk index points past the end of the file";
+            return false;
+        }
+        ChunkHeader header = readStruct<ChunkHeader>(_chunks[chunk].offset);
+        _idBases[chunk] = chunk == 0 || header.newIdCount >= header.droneCount ? chunk : _idBases[chunk - 1];
+    }
+    return true;
+}
+
+bool TelemetryRecordingReader::loadChunkIds(int chunk)
+{
+    // Each chunk keeps the IDs of the chunk before up to its first new one
+    int base = _idBases[chunk];
+    int first = base;
+    if (_idsChunk >= 0 && _idsChunk <= chunk && _idBases[_idsChunk] == base)
+    {
+        first = _idsChunk + 1; // Playing forwards: carry on from the IDs we hold
+    }
+    else if (_baseChunk == base)
+    {
+        _chunkIds = _baseIds;
+        first = base + 1;
+    }
+    else
+    {
+        _chunkIds.clear();
+    }
+
+    _idsChunk = -1;
+    for (int i = first; i <= chunk; ++i)
+    {
+        ChunkHeader header = readStruct<ChunkHeader>(_chunks[i].offset);
+        if (header.newIdCount > header.droneCount)
+        {
+            return false;
+        }
+        _chunkIds.resize(static_cast<int>(header.droneCount - header.newIdCount), DroneNameTable::INVALID_DRONE_ID);
+        if (!readIds(_data + _chunks[i].offset + sizeof(ChunkHeader), _data + _size, header.newIdCount, _chunkIds))
+        {
+            return false;
+        }
+        if (i == base)
+        {
+            _baseChunk = base;
+            _baseIds = _chunkIds;
+        }
+    }
+    _idsChunk = chunk;
+    return true;
+}
+
+const quint8* TelemetryRecordingReader::readIds(const quint8* in, const quint8* end, quint32 count,
+                                                QVector<DroneId>& ids) const
+{
+    QVector<QString> names;
+    names.reserve(static_cast<int>(qMin<quint64>(count, (end - in) / sizeof(quint16))));
+    for (quint32 i = 0; i < count; ++i)
+    {
+        if (end - in < static_cast<qint64>(sizeof(quint16)))
+        {
+            return nullptr;
+        }
+        quint16 length;
+        std::memcpy(&length, in, sizeof(length));
+        in += sizeof(length);
+        if (end - in < length)
+        {
+            return nullptr;
+        }
+        names.append(QString::fromUtf8(reinterpret_cast<const char*>(in), length));
+        in += length;
+    }
+
+    int first = ids.size();
+    ids.resize(first + names.size());
+    DroneNameTable::getInstance().internAll(names.constData(), names.size(), ids.data() + first);
+    return in;
+}
+
+quint64 TelemetryRecordingReader::framesOffset(const ChunkIndexEntry& entry) const
+{
+    if (entry.offset + sizeof(ChunkHeader) > _size)
+    {
+        return 0;
+    }
+    ChunkHeader chunk = readStruct<ChunkHeader>(entry.offset);
+    if (chunk.magic != CHUNK_MAGIC)
+    {
+        return 0;
+    }
+
+    quint64 offset = entry.offset + sizeof(ChunkHeader);
+    for (quint32 i = 0; i < chunk.newIdCount; ++i)
+    {
+        if (offset + sizeof(quint16) > _size)
+        {
+            return 0;
+        }
+        offset += sizeof(quint16) + readStruct<quint16>(offset);
+    }
+    return alignOffset(offset);
+}
+
+bool TelemetryRecordingReader::enterChunk(int chunk)
+{
+    const ChunkIndexEntry& entry = _chunks[chunk];
+    quint64 offset = framesOffset(entry);
+    if (offset == 0)
+    {
+        LOG_ERROR(QString("Corrupt chunk header at offset %1 of %2").arg(entry.offset).arg(_file.fileName()));
+        return false;
+    }
+
+    quint64 chunkEnd = qMin(_size, entry.offset + readStruct<ChunkHeader>(entry.offset).chunkBytes);
+    _frameOffsets.clear();
+    _frameOffsets.reserve(static_cast<int>(entry.frameCount));
+    _frameSlotChanges.clear();
+    _frameSlotChanges.reserve(static_cast<int>(entry.frameCount));
+    for (quint32 frame = 0; frame < entry.frameCount; ++frame)
+    {
+        FrameHeader header = offset + sizeof(FrameHeader) <= chunkEnd ? readStruct<FrameHeader>(offset) : FrameHeader();
+        if (offset + sizeof(FrameHeader) > chunkEnd || offset + sizeof(FrameHeader) + header.payloadBytes > chunkEnd ||
+            header.slotChangeBytes > header.payloadBytes)
+        {
+            LOG_ERROR(QString("Corrupt frame at offset %1 of %2").arg(offset).arg(_file.fileName()));
+            _chunk = -1;
+            return false;
+        }
+        _frameOffsets.append(offset);
+        _frameSlotChanges.append(header.slotChangeBytes);
+        offset += sizeof(FrameHeader) + header.payloadBytes;
+    }
+
+    if (!loadChunkIds(chunk))
+    {
+        LOG_ERROR(QString("Corrupt drone IDs in chunk at offset %1 of %2").arg(entry.offset).arg(_file.fileName()));
+        _chunk = -1;
+        return false;
+    }
+
+    _chunk = chunk;
+    restartChunk();
+    return true;
+}
+
+void TelemetryRecordingReader::restartChunk()
+{
+    _frame = -1;
+    _droneCount = static_cast<int>(_chunks[_chunk].droneCount);
+    _values.fill(0, _droneCount * COLUMN_COUNT); // Keyframes are deltas against zero
+    _slotIds = _chunkIds;
+    _slotIds.resize(_droneCount, DroneNameTable::INVALID_DRONE_ID);
+    _slotIdsChanged = true;
+}
+
+bool TelemetryRecordingReader::applyFrame(int frame, int direction)
+{
+    quint64 offset = _frameOffsets[frame];
+    FrameHeader header = readStruct<FrameHeader>(offset);
+    const quint8* in = _data + offset + sizeof(FrameHeader);
+    const quint8* end = in + header.payloadBytes;
+    if (header.slotChangeBytes != 0)
+    {
+        if (!applySlotChanges(in, header.slotChangeBytes))
+        {
+            LOG_ERROR(QString("Corrupt slot changes at offset %1 of %2").arg(offset).arg(_file.fileName()));
+            _chunk = -1;
+            return false;
+        }
+        in += header.slotChangeBytes;
+    }
+
+    qint32* values = _values.data();
+    int count = _values.size();
+    for (int i = 0; i < count; ++i)
+    {
+        qint64 delta = 0;
+        in = readDelta(in, end, delta);
+        if (!in)
+        {
+            LOG_ERROR(QString("Corrupt frame data at offset %1 of %2").arg(offset).arg(_file.fileName()));
+            _chunk = -1;
+            return false;
+        }
+        values[i] = static_cast<qint32>(values[i] + direction * delta);
+    }
+    return true;
+}
+
+bool TelemetryRecordingReader::applySlotChanges(const quint8* in, quint32 bytes)
+{
+    const quint8* end = in + bytes;
+    SlotChangeHeader header;
+    if (bytes < sizeof(header))
+    {
+        return false;
+    }
+    std::memcpy(&header, in, sizeof(header));
+    in += sizeof(header);
+    int previousCount = _droneCount;
+    if (header.changeCount > (bytes - sizeof(header)) / sizeof(SlotChange) ||
+        header.droneCount > static_cast<quint32>(previousCount) + header.changeCount)
+    {
+        return false;
+    }
+    int count = static_cast<int>(header.droneCount);
+    QVector<SlotChange> changes(static_cast<int>(header.changeCount));
+    std::memcpy(changes.data(), in, header.changeCount * sizeof(SlotChange));
+    in += header.changeCount * sizeof(SlotChange);
+
+    // The IDs of the new drones follow the changes, in the same order
+    quint32 newCount = 0;
+    for (const SlotChange& change : changes)
+    {
+        if (change.slot >= header.droneCount ||
+            (change.source != NEW_DRONE && change.source >= static_cast<quint32>(previousCount)))
+        {
+            return false;
+        }
+        newCount += change.source == NEW_DRONE ? 1 : 0;
+    }
+    QVector<DroneId> newIds;
+    if (!readIds(in, end, newCount, newIds))
+    {
+        return false;
+    }
+
+    // Slots without a change keep their drone; new drones are deltas against zero
+    int kept = qMin(count, previousCount);
+    _remapped.fill(0, count * COLUMN_COUNT);
+    for (int column = 0; column < COLUMN_COUNT; ++column)
+    {
+        std::memcpy(_remapped.data() + column * count, _values.constData() + column * previousCount,
+                    kept * sizeof(qint32));
+    }
+    QVector<DroneId> ids = _slotIds;
+    ids.resize(count, DroneNameTable::INVALID_DRONE_ID);
+
+    int newIndex = 0;
+    for (const SlotChange& change : changes)
+    {
+        int slot = static_cast<int>(change.slot);
+        if (change.source == NEW_DRONE)
+        {
+            ids[slot] = newIds[newIndex++];
+            for (int column = 0; column < COLUMN_COUNT; ++column)
+            {
+                _remapped[column * count + slot] = 0;
+            }
+            continue;
+        }
+        int source = static_cast<int>(change.source);
+        ids[slot] = _slotIds[source];
+        for (int column = 0; column < COLUMN_COUNT; ++column)
+        {
+            _remapped[column * count + slot] = _values.at(column * previousCount + source);
+        }
+    }
+
+    _values.swap(_remapped);
+    _slotIds.swap(ids);
+    _droneCount = count;
+    _slotIdsChanged = true;
+    return true;
+}
@@ -0,0 +1,129 @@
+#include "telemetryreplay.h"
+#include "telemetrymodel.h"
+#include "logger.h"
+#include <QTimer>
+
+TelemetryReplay::TelemetryReplay(TelemetryModel* model, QObject* parent)
+    : QObject(parent)
+    , _model(model)
+    , _playbackTimer(new QTimer(this))
+    , _position(0.0)
+    , _speed(1.0)
+    , _shownFrame(-1)
+{
+    _playbackTimer->setInterval(PLAYBACK_INTERVAL_MS);
+    _playbackTimer->setTimerType(Qt::PreciseTimer);
+    connect(_playbackTimer, &QTimer::timeout, this, &TelemetryReplay::onPlaybackTimeout);
+}
+
+bool TelemetryReplay::open(const QString& path)
+{
+    close();
+
+    if (!_reader.open(path))
+    {
+        _errorString = _reader.getErrorString();
+        LOG_ERROR(QString("Failed to open recording %1: %2").arg(path, _errorString));
+        return false;
+    }
+    if (_reader.getFrameCount() == 0)
+    {
+        _errorString = "The recording holds no frames";
+        _reader.close();
+        return false;
+    }
+
+    _errorString.clear();
+    seek(_reader.getStartTime());
+    return true;
+}
+
+void TelemetryReplay::close()
+{
+    pause();
+    _reader.close();
+    _shownFrame = -1;
+    _position = 0.0;
+}
+
+void TelemetryReplay::setSpeed(double speed)
+{
+    _speed = qBound(-MAX_SPEED, speed, MAX_SPEED);
+    LOG_INFO(QString("Replay speed set to %1x").arg(_speed));
+}
+
+void TelemetryReplay::play()
+{
+    if (!isOpen() || isPlaying())
+    {
+        return;
+    }
+
+    // Playing forwards from the end (or backwards from the start) starts over
+    if (_speed > 0.0 && _position >= getEndTime())
+    {
+        _position = getStartTime();
+    }
+    else if (_speed < 0.0 && _position <= getStartTime())
+    {
+        _position = getEndTime();
+    }
+
+    _wallClock.start();
+    _playbackTimer->start();
+    emit playingChanged(true);
+}
+
+void TelemetryReplay::pause()
+{
+    if (isPlaying())
+    {
+        _playbackTimer->stop();
+        emit playingChanged(false);
+    }
+}
+
+bool TelemetryReplay::isPlaying() const
+{
+    return _playbackTimer->isActive();
+}
+
+void TelemetryReplay::seek(double simulationTime)
+{
+    if (!isOpen())
+    {
+        return;
+    }
+    _position = qBound(getStartTime(), simulationTime, getEndTime());
+    showPosition();
+}
+
+void TelemetryReplay::onPlaybackTimeout()
+{
+    // Frames that fall between two clock ticks are skipped, as on a live display
+    double elapsedSeconds = _wallClock.restart() / 1000.0;
+    _position = qBound(getStartTime(), _position + _speed * elapsedSeconds, getEndTime());
+    showPosition();
+
+    if ((_speed > 0.0 && _position >= getEndTime()) || (_speed < 0.0 && _position <= getStartTime()))
+    {
+        pause();
+    }
+}
+
+void TelemetryReplay::showPosition()
+{
+    qint64 frame = static_cast<qint64>(_reader.findFrame(_position));
+    if (frame != _shownFrame)
+    {
+        TelemetrySnapshot snapshot;
+        if (!_reader.readFrame(static_cast<quint64>(frame), snapshot))
+        {
+            pause();
+            return;
+        }
+        _model->loadSnapshot(snapshot);
+        _shownFrame = frame;
+    }
+    emit positionChanged(_position);
+}
@@ -0,0 +1,39 @@
+#include "telemetrysnapshotbuffer.h"
+
+TelemetrySnapshotBuffer::TelemetrySnapshotBuffer()
+    : _back(0)
+    , _front(2)
+    , _middle(1)
+    , _changedFields(0)
+    , _skippedCount(0)
+{
+}
+
+void TelemetrySnapshotBuffer::publish(quint32 changedFields)
+{
+    // Release: the consumer that swaps the slot in sees everything written to it
+    quint32 previous = _middle.exchange(static_cast<quint32>(_back) | FRESH_FLAG, std::memory_order_acq_rel);
+    _back = static_cast<int>(previous & INDEX_MASK);
+
+    if (previous & FRESH_FLAG)
+    {
+        // The consumer never picked the old middle snapshot up
+        _skippedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Record the fields after the snapshot is visible, so a consumer that takes
+    // them always finds a snapshot at least this new
+    _changedFields.fetch_or(changedFields, std::memory_order_release);
+}
+
+bool TelemetrySnapshotBuffer::acquireLatest()
+{
+    if (!(_middle.load(std::memory_order_relaxed) & FRESH_FLAG))
+    {
+        return false;
+    }
+
+    quint32 previous = _middle.exchange(static_cast<quint32>(_front), std::memory_order_acq_rel);
+    _front = static_cast<int>(previous & INDEX_MASK);
+    return true;
+}
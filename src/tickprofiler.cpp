@@ -0,0 +1,160 @@
+#include "tickprofiler.h"
+#include "logger.h"
+#include <QFile>
+#include <QTextStream>
+
+namespace
+{
+constexpr int NAME_WIDTH = -20;  // Left-aligned phase name column
+constexpr int COUNT_WIDTH = 10;  // Count column
+constexpr int VALUE_WIDTH = 11;  // Microsecond columns
+
+/**
+ * @brief Format nanoseconds as microseconds for the report
+ */
+QString microseconds(double ns)
+{
+    return QString("%1").arg(ns / 1000.0, VALUE_WIDTH, 'f', 1);
+}
+}
+
+TickProfiler::TickProfiler()
+    : _tickBudgetNs(0)
+    , _overrunCount(0)
+    , _worstOverrunNs(0)
+    , _lastOverrunReportNs(-OVERRUN_REPORT_INTERVAL_NS)
+    , _resetNs(now())
+{
+}
+
+const char* TickProfiler::phaseName(Phase phase)
+{
+    switch (phase)
+    {
+    case TICK_PHASE:
+        return "Tick";
+    case FLEET_UPDATE_PHASE:
+        return "Fleet update";
+    case STRATEGY_PHASE:
+        return "  Strategy (CPU)";
+    case BATTERY_PHASE:
+        return "  Battery (CPU)";
+    case SPATIAL_INDEX_PHASE:
+        return "Spatial index";
+    case CONFLICT_DETECTION_PHASE:
+        return "Conflict detection";
+    case PUBLISH_PHASE:
+        return "Snapshot publish";
+    case RECORD_PHASE:
+        return "Recording";
+    case SIGNAL_PHASE:
+        return "Signal fan-out";
+    case WAKE_UP_PHASE:
+        return "Simulator wake-up";
+    case LOGGING_PHASE:
+        return "Logging";
+    case UI_REFRESH_PHASE:
+        return "UI refresh";
+    default:
+        return "Unknown";
+    }
+}
+
+bool TickProfiler::recordTick(qint64 durationNs)
+{
+    _histograms[TICK_PHASE].record(durationNs);
+
+    qint64 budgetNs = getTickBudget();
+    if (budgetNs <= 0 || durationNs <= budgetNs)
+    {
+        return false;
+    }
+
+    _overrunCount.fetch_add(1, std::memory_order_relaxed);
+    qint64 worst = _worstOverrunNs.load(std::memory_order_relaxed);
+    while (durationNs > worst && !_worstOverrunNs.compare_exchange_weak(worst, durationNs, std::memory_order_relaxed))
+    {
+    }
+
+    // Rate-limit reports so a persistently slow simulation does not flood the log
+    qint64 nowNs = now();
+    qint64 lastReportNs = _lastOverrunReportNs.load(std::memory_order_relaxed);
+    return nowNs - lastReportNs >= OVERRUN_REPORT_INTERVAL_NS &&
+           _lastOverrunReportNs.compare_exchange_strong(lastReportNs, nowNs, std::memory_order_relaxed);
+}
+
+void TickProfiler::setTickBudget(qint64 budgetNs)
+{
+    _tickBudgetNs.store(qMax<qint64>(0, budgetNs), std::memory_order_relaxed);
+}
+
+void TickProfiler::reset()
+{
+    for (LatencyHistogram& histogram : _histograms)
+    {
+        histogram.reset();
+    }
+    _overrunCount.store(0, std::memory_order_relaxed);
+    _worstOverrunNs.store(0, std::memory_order_relaxed);
+    _resetNs.store(now(), std::memory_order_relaxed);
+}
+
+QString TickProfiler::formatReport() const
+{
+    QString report;
+    QTextStream out(&report);
+
+    double elapsedSeconds = (now() - _resetNs.load(std::memory_order_relaxed)) / 1e9;
+    out << QString("Tick profile over %1 s").arg(elapsedSeconds, 0, 'f', 1);
+    qint64 budgetNs = getTickBudget();
+    if (budgetNs > 0)
+    {
+        out << QString(", tick budget %1 ms, %2 overrun(s)")
+               .arg(budgetNs / 1e6, 0, 'f', 3)
+               .arg(getOverrunCount());
+        if (getOverrunCount() > 0)
+        {
+            out << QString(", worst %1 ms").arg(getWorstOverrun() / 1e6, 0, 'f', 3);
+        }
+    }
+    out << '\n';
+
+    out << QString("%1").arg("Phase", NAME_WIDTH)
+        << QString("%1").arg("Count", COUNT_WIDTH)
+        << QString("%1").arg("Mean(us)", VALUE_WIDTH)
+        << QString("%1").arg("p50(us)", VALUE_WIDTH)
+        << QString("%1").arg("p99(us)", VALUE_WIDTH)
+        << QString("%1").arg("p999(us)", VALUE_WIDTH)
+        << QString("%1").arg("Max(us)", VALUE_WIDTH) << '\n';
+
+    for (int phase = 0; phase < PHASE_COUNT; ++phase)
+    {
+        LatencyHistogram::Summary summary = _histograms[phase].getSummary();
+        out << QString("%1").arg(QString(phaseName(static_cast<Phase>(phase))), NAME_WIDTH)
+            << QString("%1").arg(summary.count, COUNT_WIDTH)
+            << microseconds(summary.mean)
+            << microseconds(summary.p50)
+            << microseconds(summary.p99)
+            << microseconds(summary.p999)
+            << microseconds(summary.max) << '\n';
+    }
+
+    out.flush();
+    return report;
+}
+
+bool TickProfiler::writeReport(const QString& path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        LOG_ERROR(QString("Failed to write tick profile to %1: %2").arg(path, file.errorString()));
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << formatReport();
+    out.flush();
+    LOG_INFO(QString("Tick profile written to %1").arg(path));
+    return true;
+}
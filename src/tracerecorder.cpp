@@ -0,0 +1,208 @@
+#include "tracerecorder.h"
+#include "logger.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+
+namespace
+{
+/**
+ * @brief Quote a string for JSON
+ */
+QString jsonString(const QString& text)
+{
+    QString quoted;
+    quoted.reserve(text.size() + 2);
+    quoted += '"';
+    for (QChar c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            quoted += '\\';
+            quoted += c;
+        }
+        else if (c.unicode() < 0x20)
+        {
+            quoted += QString("\\u%1").arg(c.unicode(), 4, 16, QChar('0'));
+        }
+        else
+        {
+            quoted += c;
+        }
+    }
+    quoted += '"';
+    return quoted;
+}
+
+/**
+ * @brief Format nanoseconds as the microseconds trace viewers expect
+ */
+QString microseconds(qint64 ns)
+{
+    return QString::number(ns / 1000.0, 'f', 3);
+}
+}
+
+TraceRecorder& TraceRecorder::getInstance()
+{
+    // Never destroyed, so threads still running at exit cannot trace into freed rings
+    static TraceRecorder* instance = new TraceRecorder();
+    return *instance;
+}
+
+qint64 TraceRecorder::now()
+{
+    static const QElapsedTimer clock = []() {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+    return clock.nsecsElapsed();
+}
+
+TraceRecorder::TraceRecorder()
+    : _enabled(true)
+    , _nextThreadId(1)
+{
+}
+
+TraceRecorder::TraceRing* TraceRecorder::threadRing()
+{
+    thread_local RingLease lease;
+    if (!lease.ring)
+    {
+        QThread* thread = QThread::currentThread();
+        QString threadName = thread->objectName();
+        if (threadName.isEmpty())
+        {
+            QCoreApplication* app = QCoreApplication::instance();
+            threadName = app && app->thread() == thread ? QString("Main") : QString("Thread");
+        }
+
+        // Take over the ring of an exited thread, dropping its events, before adding one
+        QMutexLocker locker(&_mutex);
+        TraceRing* ring = nullptr;
+        for (TraceRing* candidate : _rings)
+        {
+            if (!candidate->inUse.load(std::memory_order_acquire))
+            {
+                ring = candidate;
+                ring->cleared.store(ring->written.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                ring->inUse.store(true, std::memory_order_relaxed);
+                break;
+            }
+        }
+        if (!ring)
+        {
+            ring = new TraceRing();
+            _rings.append(ring);
+        }
+        ring->threadId = _nextThreadId++;
+        ring->threadName = QString("%1 (%2)").arg(threadName).arg(ring->threadId);
+        lease.ring = ring;
+    }
+    return lease.ring;
+}
+
+void TraceRecorder::collectEvents(const TraceRing& ring, qint64 sinceNs, QVector<TraceEvent>& events)
+{
+    quint64 end = ring.written.load(std::memory_order_acquire);
+    quint64 begin = end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+    begin = qMax(begin, ring.cleared.load(std::memory_order_relaxed));
+
+    QVector<TraceEvent> copied;
+    copied.reserve(static_cast<int>(end - begin));
+    for (quint64 position = begin; position < end; ++position)
+    {
+        copied.append(ring.events[position % EVENTS_PER_THREAD]);
+    }
+
+    // The producer kept going while we copied; slots it reused hold newer, torn events, and
+    // it may be writing position after right now, which overwrites after - EVENTS_PER_THREAD
+    quint64 after = ring.written.load(std::memory_order_acquire);
+    quint64 firstIntact = after + 1 > EVENTS_PER_THREAD ? after + 1 - EVENTS_PER_THREAD : 0;
+    for (quint64 position = qMax(begin, firstIntact); position < end; ++position)
+    {
+        const TraceEvent& event = copied[static_cast<int>(position - begin)];
+        if (event.startNs + event.durationNs >= sinceNs)
+        {
+            events.append(event);
+        }
+    }
+}
+
+bool TraceRecorder::writeTrace(const QString& path, qint64 windowNs)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        LOG_ERROR(QString("Failed to write trace to %1: %2").arg(path, file.errorString()));
+        return false;
+    }
+
+    qint64 sinceNs = now() - windowNs;
+    qint64 pid = QCoreApplication::applicationPid();
+    int eventCount = 0;
+
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+
+    QMutexLocker locker(&_mutex);
+    for (const TraceRing* ring : _rings)
+    {
+        QVector<TraceEvent> events;
+        collectEvents(*ring, sinceNs, events);
+        if (events.isEmpty())
+        {
+            continue;
+        }
+
+        // Name the thread's track
+        out << (first ? "\n" : ",\n")
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << ring->threadId
+            << ",\"args\":{\"name\":" << jsonString(ring->threadName) << "}}";
+        first = false;
+
+        for (const TraceEvent& event : events)
+        {
+            out << ",\n{\"name\":" << jsonString(event.name)
+                << ",\"cat\":" << jsonString(event.category)
+                << ",\"ph\":\"X\",\"ts\":" << microseconds(event.startNs)
+                << ",\"dur\":" << microseconds(event.durationNs)
+                << ",\"pid\":" << pid << ",\"tid\":" << ring->threadId;
+            if (event.argName)
+            {
+                out << ",\"args\":{" << jsonString(event.argName) << ':' << event.argValue << '}';
+            }
+            out << '}';
+        }
+        eventCount += events.size();
+    }
+    locker.unlock();
+
+    out << "\n]}\n";
+    out.flush();
+    if (file.error() != QFileDevice::NoError)
+    {
+        LOG_ERROR(QString("Failed to write trace to %1: %2").arg(path, file.errorString()));
+        return false;
+    }
+
+    LOG_INFO(QString("Trace of the last %1 s written to %2 (%3 events)")
+             .arg(windowNs / 1e9, 0, 'f', 1)
+             .arg(path)
+             .arg(eventCount));
+    return true;
+}
+
+void TraceRecorder::clear()
+{
+    QMutexLocker locker(&_mutex);
+    for (TraceRing* ring : _rings)
+    {
+        ring->cleared.store(ring->written.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
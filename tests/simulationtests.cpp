@@ -0,0 +1,710 @@
+#include <QSet>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QtTest>
+#include "counterrng.h"
+#include "dronefactory.h"
+#include "dronenametable.h"
+#include "fixedstepscheduler.h"
+#include "fleetstate.h"
+#include "kinematics.h"
+#include "separationmonitor.h"
+#include "spatialindex.h"
+#include "telemetryrecorder.h"
+#include "telemetryrecordingreader.h"
+#include "telemetrysnapshot.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+/*
+ * Regression tests for the simulation core. Each test holds a component to
+ * something independent of its implementation: published answers, a plain
+ * reference computation, or the input it was built from.
+ */
+
+namespace
+{
+constexpr quint64 TEST_SEED = 42;       // Fixed seed so every run checks the same values
+constexpr int ROUND_TRIP_TICKS = 200;   // Frames recorded by the round-trip test
+constexpr int ROUND_TRIP_CHUNK = 8;     // Frames per chunk, so the test crosses many keyframes
+constexpr int RANDOM_SEEKS = 500;       // Random frame reads after the sequential passes
+constexpr int CHURN_ROUNDS = 300;       // Spawn/despawn rounds of the ID churn test
+constexpr int INDEX_DRONES = 3000;      // Drones in the spatial index test
+constexpr int INDEX_QUERIES = 200;      // Queries checked after every index update
+constexpr int CLUSTER_DRONES = 400;     // Drones in one spot: 79,800 conflicts, past MAX_REPORTED_CONFLICTS
+constexpr int SCHEDULER_CALLS = 1000;   // advance() calls with jittery intervals in the scheduler test
+constexpr qint64 NS_PER_MS = 1000000;
+
+/**
+ * @brief Reference heading wrap into [0, 360) built on std::fmod
+ */
+double referenceWrap(double heading)
+{
+    double wrapped = std::fmod(heading, 360.0);
+    if (wrapped < 0.0)
+    {
+        wrapped += 360.0;
+    }
+    return wrapped >= 360.0 ? wrapped - 360.0 : wrapped;
+}
+
+/**
+ * @brief Angular distance between two headings in degrees
+ */
+double headingDistance(double a, double b)
+{
+    double distance = std::fabs(a - b);
+    return qMin(distance, 360.0 - distance);
+}
+
+/**
+ * @brief Give a drone values that follow from its ID and the tick, so any frame can be checked
+ */
+void setRecordedValues(FleetState& fleet, int slot, int tick)
+{
+    DroneId id = fleet.id(slot);
+    fleet.latitudes()[slot] = 28.0 + id * 1e-3 + tick * 1e-5;
+    fleet.longitudes()[slot] = 77.0 + id * 1e-3;
+    fleet.altitudes()[slot] = 100.0 + id + tick * 0.5;
+    fleet.headings()[slot] = (id * 13 + tick) % 360;
+    fleet.speeds()[slot] = (id % 20) * 0.5;
+    fleet.batteries()[slot] = (id * 7 + tick) % 100;
+}
+
+/**
+ * @brief Check that every drone has its own valid ID and that FleetState finds each drone by it
+ */
+bool uniqueIds(const FleetState& fleet)
+{
+    QSet<DroneId> seen;
+    for (int slot = 0; slot < fleet.size(); ++slot)
+    {
+        DroneId id = fleet.id(slot);
+        if (id == DroneNameTable::INVALID_DRONE_ID || seen.contains(id) || fleet.slotOf(id) != slot)
+        {
+            return false;
+        }
+        seen.insert(id);
+    }
+    return true;
+}
+
+/**
+ * @brief Check radius, box and nearest queries at random points against a scan of the whole fleet
+ * Positions are projected with the index's own toLocal(), so only the bucketing is under test.
+ */
+bool indexMatchesScan(const SpatialIndex& index, const FleetState& fleet, std::mt19937& generator, QString& failure)
+{
+    QVector<double> x(fleet.size());
+    QVector<double> y(fleet.size());
+    for (int slot = 0; slot < fleet.size(); ++slot)
+    {
+        index.toLocal(fleet.latitudes()[slot], fleet.longitudes()[slot], x[slot], y[slot]);
+    }
+
+    std::uniform_int_distribution<int> anyDrone(0, fleet.size() - 1);
+    std::uniform_real_distribution<double> offset(-0.002, 0.002);
+    std::uniform_real_distribution<double> radius(5.0, 400.0);
+    QVector<int> result;
+    QVector<int> expected;
+    for (int query = 0; query < INDEX_QUERIES; ++query)
+    {
+        // Around a drone, so most queries find something
+        int centre = anyDrone(generator);
+        double latitude = fleet.latitudes()[centre] + offset(generator);
+        double longitude = fleet.longitudes()[centre] + offset(generator);
+        double queryRadius = radius(generator);
+        double qx = 0.0;
+        double qy = 0.0;
+        index.toLocal(latitude, longitude, qx, qy);
+
+        expected.clear();
+        int nearest = -1;
+        double nearestSquared = queryRadius * queryRadius;
+        for (int slot = 0; slot < fleet.size(); ++slot)
+        {
+            double distanceSquared = (x[slot] - qx) * (x[slot] - qx) + (y[slot] - qy) * (y[slot] - qy);
+            if (distanceSquared <= queryRadius * queryRadius)
+            {
+                expected.append(slot);
+            }
+            if (distanceSquared < nearestSquared || (distanceSquared == nearestSquared && nearest < 0))
+            {
+                nearestSquared = distanceSquared;
+                nearest = slot;
+            }
+        }
+        index.queryRadius(latitude, longitude, queryRadius, result);
+        if (result != expected)
+        {
+            failure = QString("radius %1 m around drone %2: %3 drones, expected %4")
+                      .arg(queryRadius).arg(centre).arg(result.size()).arg(expected.size());
+            return false;
+        }
+        if (index.nearest(latitude, longitude, queryRadius) != nearest)
+        {
+            failure = QString("nearest within %1 m of drone %2").arg(queryRadius).arg(centre);
+            return false;
+        }
+
+        // A box from the query point to a corner 400 m up and to the right
+        double maxLatitude = latitude + 0.0036;
+        double maxLongitude = longitude + 0.0036;
+        double maxX = 0.0;
+        double maxY = 0.0;
+        index.toLocal(maxLatitude, maxLongitude, maxX, maxY);
+        expected.clear();
+        for (int slot = 0; slot < fleet.size(); ++slot)
+        {
+            if (x[slot] >= qx && x[slot] <= maxX && y[slot] >= qy && y[slot] <= maxY)
+            {
+                expected.append(slot);
+            }
+        }
+        index.queryBox(latitude, longitude, maxLatitude, maxLongitude, result);
+        if (result != expected)
+        {
+            failure = QString("box at drone %1: %2 drones, expected %3").arg(centre).arg(result.size()).arg(expected.size());
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Compare a replayed fleet with the recorded one, within the recording's fixed-point precision
+ */
+bool sameFleet(const FleetState& replayed, const FleetState& recorded)
+{
+    if (replayed.size() != recorded.size())
+    {
+        return false;
+    }
+    for (int slot = 0; slot < recorded.size(); ++slot)
+    {
+        if (replayed.name(slot) != recorded.name(slot) ||
+            std::fabs(replayed.latitudes()[slot] - recorded.latitudes()[slot]) > 1e-6 ||
+            std::fabs(replayed.longitudes()[slot] - recorded.longitudes()[slot]) > 1e-6 ||
+            std::fabs(replayed.altitudes()[slot] - recorded.altitudes()[slot]) > 0.01 ||
+            std::fabs(replayed.headings()[slot] - recorded.headings()[slot]) > 0.01 ||
+            std::fabs(replayed.speeds()[slot] - recorded.speeds()[slot]) > 0.01 ||
+            replayed.batteries()[slot] != recorded.batteries()[slot])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+class SimulationTests : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Every instruction set wraps headings like the fmod reference
+     */
+    void wrapHeadingsMatchesFmod();
+
+    /**
+     * @brief The Philox4x32-10 bijection reproduces the Random123 known-answer vectors
+     */
+    void philoxKnownAnswers();
+
+    /**
+     * @brief Batched samples (AVX2 or scalar) match the Philox bijection, wherever a batch starts
+     */
+    void fillUniformMatchesPhilox();
+
+    /**
+     * @brief A recording with drones joining and leaving replays every frame it was given
+     */
+    void recordingRoundTrip();
+
+    /**
+     * @brief Spawning into a full name table stops short without unnamed drones, and recordings skip unnamed drones
+     */
+    void spawnStopsAtFullNameTable();
+
+    /**
+     * @brief Generated IDs skip names live drones hold, and churn reuses despawned names instead of growing the table
+     */
+    void generatedIdsStayUnique();
+
+    /**
+     * @brief Spatial index queries match a full scan after rebuilds, small moves (the moved list) and far flights
+     */
+    void spatialIndexMatchesScan();
+
+    /**
+     * @brief Past the report cap the lowest slots are kept, and each conflict is reported as new exactly once
+     */
+    void separationReportsPastCap();
+
+    /**
+     * @brief The scheduler steps once per step of scaled wall time and drops lag beyond the catch-up bound
+     */
+    void schedulerCatchesUp();
+};
+
+void SimulationTests::wrapHeadingsMatchesFmod()
+{
+    std::vector<double> input = {
+        0.0, -0.0, 360.0, -360.0, 720.0, 359.999999, -1e-9, -1e-20, 1e-20, 180.0, -180.0, 1e6, -1e6
+    };
+    std::mt19937 generator(TEST_SEED);
+    std::uniform_real_distribution<double> heading(-5000.0, 5000.0);
+    // An odd total leaves a scalar tail after every vector width
+    while (input.size() < 1003)
+    {
+        input.push_back(heading(generator));
+    }
+
+    const Kinematics::Isa isas[] = {Kinematics::Isa::Scalar, Kinematics::Isa::SSE41, Kinematics::Isa::AVX2};
+    for (Kinematics::Isa isa : isas)
+    {
+        const KinematicsKernels& kernels = Kinematics::kernels(isa);
+        std::vector<double> headings = input;
+        kernels.wrapHeadings(headings.data(), static_cast<int>(headings.size()));
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            QVERIFY2(headings[i] >= 0.0 && headings[i] < 360.0,
+                     qPrintable(QString("%1: %2 wrapped to %3").arg(kernels.name).arg(input[i]).arg(headings[i])));
+            QVERIFY2(headingDistance(headings[i], referenceWrap(input[i])) < 1e-9,
+                     qPrintable(QString("%1: %2 wrapped to %3").arg(kernels.name).arg(input[i]).arg(headings[i])));
+        }
+    }
+}
+
+void SimulationTests::philoxKnownAnswers()
+{
+    struct KnownAnswer
+    {
+        quint32 counter[4];
+        quint32 key[2];
+        quint32 expected[4];
+    };
+    const KnownAnswer answers[] = {
+        {{0x00000000, 0x00000000, 0x00000000, 0x00000000}, {0x00000000, 0x00000000},
+         {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+        {{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff},
+         {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+        {{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0},
+         {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}},
+    };
+
+    for (const KnownAnswer& answer : answers)
+    {
+        quint32 counter[4] = {answer.counter[0], answer.counter[1], answer.counter[2], answer.counter[3]};
+        CounterRng::philox(counter, answer.key);
+        for (int word = 0; word < 4; ++word)
+        {
+            QCOMPARE(counter[word], answer.expected[word]);
+        }
+    }
+}
+
+void SimulationTests::fillUniformMatchesPhilox()
+{
+    // Samples come in blocks of 8 Philox instances x 4 words; word w of instance j is drone w * 8 + j
+    const int blockInstances = 8;
+    const int blockSize = blockInstances * 4;
+    const quint32 bound = 1000;
+    const quint32 stream = 3;
+    const quint64 tick = 0x100000007ULL;
+    const CounterRng rng(TEST_SEED);
+    const quint32 key[2] = {static_cast<quint32>(TEST_SEED), static_cast<quint32>(TEST_SEED >> 32)};
+
+    // Odd starts and lengths cover partial blocks at both ends
+    const int ranges[][2] = {{0, 1}, {0, 32}, {5, 100}, {31, 2}, {64, 256}, {1000, 77}};
+    for (const auto& range : ranges)
+    {
+        int first = range[0];
+        int count = range[1];
+        std::vector<double> samples(count);
+        rng.fillUniform(samples.data(), count, bound, tick, static_cast<quint32>(first), stream);
+
+        for (int i = 0; i < count; ++i)
+        {
+            int index = first + i;
+            int offset = index % blockSize;
+            quint32 counter[4] = {
+                static_cast<quint32>(index / blockSize * blockInstances + offset % blockInstances),
+                stream,
+                static_cast<quint32>(tick),
+                static_cast<quint32>(tick >> 32)
+            };
+            CounterRng::philox(counter, key);
+            quint32 expected = static_cast<quint32>((static_cast<quint64>(counter[offset / blockInstances]) * bound) >> 32);
+            QCOMPARE(samples[i], static_cast<double>(expected));
+            QCOMPARE(rng.uniform(bound, tick, static_cast<quint32>(index), stream), expected);
+        }
+    }
+}
+
+void SimulationTests::recordingRoundTrip()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString path = directory.filePath("roundtrip.dtr");
+
+    std::mt19937 generator(TEST_SEED);
+    FleetState fleet;
+    int nextName = 0;
+    auto addDrone = [&]() {
+        fleet.addDrone(QString("DRONE-%1").arg(nextName++));
+    };
+    for (int i = 0; i < 50; ++i)
+    {
+        addDrone();
+    }
+
+    TelemetryRecorder recorder;
+    QVERIFY(recorder.open(path, ROUND_TRIP_CHUNK));
+    std::vector<FleetState> recorded;
+    for (int tick = 0; tick < ROUND_TRIP_TICKS; ++tick)
+    {
+        // Drones join and leave between frames, with a burst of arrivals now and then
+        int changes = static_cast<int>(generator() % 4);
+        for (int i = 0; i < changes; ++i)
+        {
+            if (generator() % 2 && fleet.size() > 5)
+            {
+                fleet.removeDrone(static_cast<int>(generator() % fleet.size()));
+            }
+            else
+            {
+                addDrone();
+            }
+        }
+        if (tick % 37 == 0)
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                addDrone();
+            }
+        }
+        for (int slot = 0; slot < fleet.size(); ++slot)
+        {
+            setRecordedValues(fleet, slot, tick);
+        }
+
+        TelemetrySnapshot snapshot;
+        snapshot.tick = tick;
+        snapshot.simulationTime = tick * 0.5;
+        snapshot.fleet = fleet;
+        recorded.push_back(fleet);
+        // The writer may fall behind; retry until the snapshot is queued
+        while (!recorder.record(snapshot))
+        {
+            QThread::msleep(1);
+        }
+    }
+    recorder.close();
+    QCOMPARE(recorder.getRecordedFrames(), quint64(ROUND_TRIP_TICKS));
+
+    TelemetryRecordingReader reader;
+    QVERIFY2(reader.open(path), qPrintable(reader.getErrorString()));
+    QCOMPARE(reader.getFrameCount(), quint64(ROUND_TRIP_TICKS));
+
+    // Forwards, backwards (undoing slot changes), then random seeks across chunks
+    TelemetrySnapshot snapshot;
+    std::vector<quint64> frames;
+    for (quint64 frame = 0; frame < quint64(ROUND_TRIP_TICKS); ++frame)
+    {
+        frames.push_back(frame);
+    }
+    for (quint64 frame = quint64(ROUND_TRIP_TICKS); frame-- > 0;)
+    {
+        frames.push_back(frame);
+    }
+    for (int i = 0; i < RANDOM_SEEKS; ++i)
+    {
+        frames.push_back(generator() % ROUND_TRIP_TICKS);
+    }
+    for (quint64 frame : frames)
+    {
+        QVERIFY(reader.readFrame(frame, snapshot));
+        QCOMPARE(snapshot.tick, frame);
+        QVERIFY2(sameFleet(snapshot.fleet, recorded[frame]), qPrintable(QString("frame %1 differs").arg(frame)));
+    }
+}
+
+void SimulationTests::spawnStopsAtFullNameTable()
+{
+    DroneNameTable& names = DroneNameTable::getInstance();
+    FleetState fleet;
+    SpawnDescriptor descriptor;
+    descriptor.idPrefix = "CAP-";
+    descriptor.count = 10;
+    int nextNumber = 1;
+    QCOMPARE(DroneFactory::spawnDrones(&fleet, descriptor, &nextNumber), 10);
+
+    // Room for 5 more names: a spawn of 20 gets 5, the next gets none, and despawned names still come back
+    names.setCapacity(names.size() + 5);
+    descriptor.count = 20;
+    int partial = DroneFactory::spawnDrones(&fleet, descriptor, &nextNumber);
+    int sizeAfterPartial = fleet.size();
+    int whenFull = DroneFactory::spawnDrones(&fleet, descriptor, &nextNumber);
+    QVector<DroneId> freeIds = {fleet.id(1), fleet.id(0)};
+    fleet.removeDrone(1);
+    fleet.removeDrone(0);
+    int recycled = DroneFactory::spawnDrones(&fleet, descriptor, &nextNumber, &freeIds);
+    names.setCapacity(DroneNameTable::MAX_NAMES);
+
+    QCOMPARE(partial, 5);
+    QCOMPARE(sizeAfterPartial, 15);
+    QCOMPARE(whenFull, 0);
+    QCOMPARE(recycled, 2);
+    QCOMPARE(fleet.size(), 15);
+    QVERIFY(freeIds.isEmpty());
+    QSet<DroneId> distinct;
+    for (int slot = 0; slot < fleet.size(); ++slot)
+    {
+        QVERIFY(fleet.id(slot) != DroneNameTable::INVALID_DRONE_ID);
+        QCOMPARE(fleet.slotOf(fleet.id(slot)), slot);
+        distinct.insert(fleet.id(slot));
+    }
+    QCOMPARE(distinct.size(), qsizetype(fleet.size()));
+
+    // A frame holding a drone without an ID is dropped; the frames around it are recorded
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    TelemetryRecorder recorder;
+    QVERIFY(recorder.open(directory.filePath("unnamed.dtr"), ROUND_TRIP_CHUNK));
+    TelemetrySnapshot snapshot;
+    snapshot.fleet = fleet;
+    QVERIFY(recorder.record(snapshot));
+    snapshot.tick = 1;
+    snapshot.fleet.addDrones(1);
+    while (!recorder.record(snapshot))
+    {
+        QThread::msleep(1);
+    }
+    snapshot.tick = 2;
+    snapshot.fleet = fleet;
+    while (!recorder.record(snapshot))
+    {
+        QThread::msleep(1);
+    }
+    recorder.close();
+    QCOMPARE(recorder.getRecordedFrames(), quint64(2));
+    QCOMPARE(recorder.getDroppedFrames(), quint64(1));
+
+    TelemetryRecordingReader reader;
+    QVERIFY2(reader.open(directory.filePath("unnamed.dtr")), qPrintable(reader.getErrorString()));
+    QCOMPARE(reader.getFrameCount(), quint64(2));
+    QVERIFY(reader.readFrame(1, snapshot));
+    QCOMPARE(snapshot.tick, quint64(2));
+    QVERIFY(sameFleet(snapshot.fleet, fleet));
+}
+
+void SimulationTests::generatedIdsStayUnique()
+{
+    // Drones from a spawn file already hold two of the numbers the counter would generate
+    FleetState fleet;
+    fleet.addDrone("UNIQUE-002");
+    fleet.addDrone("UNIQUE-005");
+    int first = fleet.addDrones(6);
+    int nextNumber = 1;
+    QCOMPARE(DroneFactory::assignGeneratedIds(&fleet, first, 6, "UNIQUE-", &nextNumber), 6);
+    QCOMPARE(nextNumber, 9);
+    QVERIFY(uniqueIds(fleet));
+    QCOMPARE(fleet.name(first), QString("UNIQUE-001"));
+    QCOMPARE(fleet.name(first + 5), QString("UNIQUE-008"));
+
+    // Random despawns and spawns: despawned names come back, so the table grows only with the peak fleet
+    DroneNameTable& names = DroneNameTable::getInstance();
+    std::mt19937 generator(TEST_SEED);
+    QVector<DroneId> freeIds;
+    SpawnDescriptor descriptor;
+    descriptor.idPrefix = "UNIQUE-";
+    int namesBefore = names.size();
+    int peak = fleet.size();
+    for (int round = 0; round < CHURN_ROUNDS; ++round)
+    {
+        int despawns = static_cast<int>(generator() % 8);
+        for (int i = 0; i < despawns && fleet.size() > 1; ++i)
+        {
+            int slot = static_cast<int>(generator() % fleet.size());
+            freeIds.append(fleet.id(slot));
+            fleet.removeDrone(slot);
+        }
+        descriptor.count = static_cast<int>(generator() % 8);
+        QCOMPARE(DroneFactory::spawnDrones(&fleet, descriptor, &nextNumber, &freeIds), descriptor.count);
+        QVERIFY2(uniqueIds(fleet), qPrintable(QString("round %1").arg(round)));
+        peak = qMax(peak, fleet.size());
+    }
+    QVERIFY(names.size() - namesBefore <= peak);
+}
+
+void SimulationTests::spatialIndexMatchesScan()
+{
+    std::mt19937 generator(TEST_SEED);
+    std::uniform_real_distribution<double> spread(-0.02, 0.02);
+    FleetState fleet;
+    for (int i = 0; i < INDEX_DRONES; ++i)
+    {
+        fleet.addDrone(QString("INDEX-%1").arg(i), FleetState::DEFAULT_LATITUDE + spread(generator),
+                       FleetState::DEFAULT_LONGITUDE + spread(generator), FleetState::DEFAULT_ALTITUDE);
+    }
+
+    SpatialIndex index;
+    index.update(fleet);
+    QVERIFY(index.wasRebuilt());
+    QCOMPARE(index.size(), fleet.size());
+    QString failure;
+    QVERIFY2(indexMatchesScan(index, fleet, generator, failure), qPrintable(failure));
+
+    // A few drones crossing cells each tick are merged in from the moved list, without a rebuild
+    std::uniform_int_distribution<int> anyDrone(0, INDEX_DRONES - 1);
+    std::uniform_real_distribution<double> step(-0.0006, 0.0006);
+    int mergedUpdates = 0;
+    for (int tick = 0; tick < 20; ++tick)
+    {
+        for (int i = 0; i < INDEX_DRONES / 50; ++i)
+        {
+            int slot = anyDrone(generator);
+            fleet.latitudes()[slot] += step(generator);
+            fleet.longitudes()[slot] += step(generator);
+        }
+        index.update(fleet);
+        mergedUpdates += index.wasRebuilt() ? 0 : 1;
+        QVERIFY2(indexMatchesScan(index, fleet, generator, failure),
+                 qPrintable(QString("tick %1: %2").arg(tick).arg(failure)));
+    }
+    QVERIFY(mergedUpdates > 0);
+
+    // Flying the whole fleet 15 km north moves the reference point and rebuilds
+    for (int slot = 0; slot < fleet.size(); ++slot)
+    {
+        fleet.latitudes()[slot] += 0.135;
+    }
+    index.update(fleet);
+    QVERIFY(index.wasRebuilt());
+    QVERIFY2(indexMatchesScan(index, fleet, generator, failure), qPrintable(failure));
+
+    // Despawns move drones to other slots, which rebuilds too
+    fleet.removeDrone(0);
+    fleet.removeDrone(fleet.size() / 2);
+    index.update(fleet);
+    QCOMPARE(index.size(), fleet.size());
+    QVERIFY2(indexMatchesScan(index, fleet, generator, failure), qPrintable(failure));
+}
+
+void SimulationTests::separationReportsPastCap()
+{
+    // Every pair of a tight cluster is in conflict
+    std::mt19937 generator(TEST_SEED);
+    std::uniform_real_distribution<double> jitter(-0.00005, 0.00005);
+    FleetState fleet;
+    for (int i = 0; i < CLUSTER_DRONES; ++i)
+    {
+        fleet.addDrone(QString("CLUSTER-%1").arg(i), FleetState::DEFAULT_LATITUDE + jitter(generator),
+                       FleetState::DEFAULT_LONGITUDE + jitter(generator), FleetState::DEFAULT_ALTITUDE);
+    }
+    const int pairs = CLUSTER_DRONES * (CLUSTER_DRONES - 1) / 2;
+    const int cap = SeparationMonitor::MAX_REPORTED_CONFLICTS;
+    QVERIFY(pairs > cap);
+
+    SpatialIndex index;
+    SeparationMonitor monitor;
+    auto detect = [&]() {
+        index.update(fleet);
+        monitor.detect(fleet, index);
+    };
+
+    // The kept conflicts are the pairs with the lowest slots, in slot order
+    detect();
+    QCOMPARE(monitor.getConflictCount(), qint64(pairs));
+    QCOMPARE(monitor.getConflicts().size(), qsizetype(cap));
+    QCOMPARE(monitor.getNewConflicts().size(), qsizetype(cap));
+    int kept = 0;
+    for (int first = 0; first < CLUSTER_DRONES && kept < cap; ++first)
+    {
+        for (int second = first + 1; second < CLUSTER_DRONES && kept < cap; ++second, ++kept)
+        {
+            const SeparationConflict& conflict = monitor.getConflicts()[kept];
+            QVERIFY2(conflict.firstSlot == first && conflict.secondSlot == second,
+                     qPrintable(QString("conflict %1 is %2-%3, expected %4-%5")
+                                .arg(kept).arg(conflict.firstSlot).arg(conflict.secondSlot).arg(first).arg(second)));
+        }
+    }
+
+    // Nothing changed, nothing new
+    detect();
+    QCOMPARE(monitor.getNewConflicts().size(), qsizetype(0));
+
+    // Lifting drone 0 clear ends its conflicts; the kept window slides up, and
+    // the conflicts it now takes in were never reported, so they are new
+    const int dronePairs = CLUSTER_DRONES - 1;
+    fleet.altitudes()[0] += 50.0;
+    detect();
+    QCOMPARE(monitor.getConflictCount(), qint64(pairs - dronePairs));
+    QCOMPARE(monitor.getNewConflicts().size(), qsizetype(dronePairs));
+
+    // Lowering it starts its conflicts again and pushes the window's tail out of the report
+    fleet.altitudes()[0] -= 50.0;
+    detect();
+    QCOMPARE(monitor.getNewConflicts().size(), qsizetype(dronePairs));
+    for (const SeparationConflict& conflict : monitor.getNewConflicts())
+    {
+        QCOMPARE(conflict.firstSlot, 0);
+    }
+
+    // The tail was still tracked while it was not reported, so it does not come back as new
+    fleet.altitudes()[0] += 50.0;
+    detect();
+    QCOMPARE(monitor.getNewConflicts().size(), qsizetype(0));
+    QCOMPARE(monitor.getStartedCount(), quint64(cap + 2 * dronePairs));
+}
+
+void SimulationTests::schedulerCatchesUp()
+{
+    // Jittery intervals within the catch-up bound: every step of wall time is run, none dropped.
+    // Whole milliseconds plus 1 ns per call keep the total off the step boundaries.
+    std::mt19937 generator(TEST_SEED);
+    FixedStepScheduler scheduler(0.5, 8);
+    qint64 wallNs = 1000 * NS_PER_MS;
+    scheduler.start(wallNs);
+    qint64 elapsedMs = 0;
+    qint64 steps = 0;
+    for (int call = 0; call < SCHEDULER_CALLS; ++call)
+    {
+        qint64 intervalMs = generator() % 600;
+        elapsedMs += intervalMs;
+        wallNs += intervalMs * NS_PER_MS + 1;
+        steps += scheduler.advance(wallNs);
+        QCOMPARE(steps, elapsedMs / 500);
+    }
+    QCOMPARE(scheduler.getDroppedSteps(), quint64(0));
+
+    // A 2 s stall owes 20 steps of 0.1 s: 8 run, 12 are dropped, and no backlog is left to snowball
+    scheduler.setStepSeconds(0.1);
+    scheduler.start(wallNs);
+    wallNs += 2000 * NS_PER_MS + 1;
+    QCOMPARE(scheduler.advance(wallNs), 8);
+    QCOMPARE(scheduler.getDroppedSteps(), quint64(12));
+    wallNs += 50 * NS_PER_MS;
+    QCOMPARE(scheduler.advance(wallNs), 0);
+    wallNs += 60 * NS_PER_MS;
+    QCOMPARE(scheduler.advance(wallNs), 1);
+
+    // The time scale multiplies the steps owed, and the same bound applies
+    scheduler.setStepSeconds(0.5);
+    scheduler.setTimeScale(10.0);
+    scheduler.start(wallNs);
+    wallNs += 1000 * NS_PER_MS + 1;
+    QCOMPARE(scheduler.advance(wallNs), 8);
+    QCOMPARE(scheduler.getDroppedSteps(), quint64(24));
+    wallNs += 100 * NS_PER_MS + 1;
+    QCOMPARE(scheduler.advance(wallNs), 2);
+
+    // A clock going backwards owes nothing
+    QCOMPARE(scheduler.advance(wallNs - 500 * NS_PER_MS), 0);
+}
+
+QTEST_GUILESS_MAIN(SimulationTests)
+#include "simulationtests.moc"